@@ -28,6 +28,12 @@ set(LINKERHAND_EXAMPLES
     L10/action_group_show
     range_to_arc/range_to_arc
     test_conversion
+    test_request_plan
+    test_poll_stamp
+    test_trajectory
+    test_async_hand
+    test_state_history
+    test_session
 )
 
 # 需要 CanFD 支持的示例：仅在非 aarch64 的 Linux 且 USE_CANFD=ON 时构建
@@ -39,7 +45,28 @@ set(LINKERHAND_EXAMPLES_CANFD
 )
 
 # 仅 Linux 构建：SocketCAN 原生 CANFD（CanFDSocket），只用内核 linux/can.h，
-# 无需 libcanbus，不受 USE_CANFD 门控。
+# 无需 libcanbus，不受 USE_CANFD 门控。test_rt_check 用 dlsym 拦截 pthread_mutex_lock，
+# test_hand_manager 依赖 epoll / eventfd，同样仅 Linux。
 set(LINKERHAND_EXAMPLES_LINUX
     test_o20_canfd_socket_0
+    test_rt_check
+    test_hand_manager
+)
+
+# C++20 协程示例（include/api/Coroutine.h）：仅 Linux，且需 BUILD_COROUTINE_EXAMPLES=ON，
+# 以 C++20 单独编译，其余示例保持 C++17。
+set(LINKERHAND_EXAMPLES_COROUTINE
+    test_coroutine
+)
+
+# 无需硬件的自检示例（须同时在上面的列表中登记）：构建后登记为 ctest 用例，用例名去掉 test_ 前缀。
+set(LINKERHAND_EXAMPLE_CHECKS
+    test_rt_check
+    test_request_plan
+    test_poll_stamp
+    test_trajectory
+    test_async_hand
+    test_state_history
+    test_session
+    test_hand_manager
 )
@@ -0,0 +1,166 @@
+// 异步请求层检查：模拟一只 L10 回显读请求，AsyncHand 接入 RequestCorrelator 后，断言
+// 同一批读请求都拿到设备的新值（不是上一次的缓存）、请求帧只发一次且全部匹配、
+// 缺失应答的请求以 HandError::Timeout 失败，写指令与回调版本的读请求照常完成。
+// 无需硬件，失败时返回非 0（已登记为 ctest 用例 async_hand）。
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "AsyncHand.h"
+
+using namespace linkerhand;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool ok, const char* what)
+{
+    std::printf("%-48s %s\n", what, ok ? "ok" : "FAILED");
+    if (!ok) ++failures;
+}
+
+// 模拟设备：单字节读请求回显命令字，其余字节填 value；drop 中的命令不应答
+struct FakeHand {
+    std::mutex mutex;
+    std::deque<std::pair<uint32_t, std::vector<uint8_t>>> replies;
+    std::set<uint8_t> drop;
+    std::vector<std::vector<uint8_t>> writes;  // 多字节帧（写指令）
+    uint8_t value = 0;
+
+    int32_t tx(uint32_t can_id, const uint8_t* data, uintptr_t len)
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        if (len != 1) {
+            writes.emplace_back(data, data + len);
+            return 0;
+        }
+        if (drop.count(data[0]) != 0) return 0;
+        std::vector<uint8_t> d(8, value);
+        d[0] = data[0];
+        replies.emplace_back(can_id, std::move(d));
+        return 0;
+    }
+
+    int32_t rx(uint32_t* can_id, uint8_t* data, uint8_t* len)
+    {
+        std::unique_lock<std::mutex> lk(mutex);
+        if (replies.empty()) {
+            lk.unlock();
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            return -1;
+        }
+        const auto f = std::move(replies.front());
+        replies.pop_front();
+        lk.unlock();
+        *can_id = f.first;
+        std::memcpy(data, f.second.data(), f.second.size());
+        *len = static_cast<uint8_t>(f.second.size());
+        return 0;
+    }
+
+    void set(uint8_t v)
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        value = v;
+    }
+};
+
+bool allEqual(const std::vector<uint8_t>& v, size_t n, uint8_t value)
+{
+    if (v.size() != n) return false;
+    for (uint8_t b : v) {
+        if (b != value) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main()
+{
+    const LINKER_HAND model = LINKER_HAND::L10;
+    const HAND_TYPE side = HAND_TYPE::RIGHT;
+    FakeHand dev;
+    LinkerHandApi hand(model, side);
+    communication::RequestCorrelator correlator;
+    hand.setCanTxCallback(correlator.wrapTx([&dev](uint32_t id, const uint8_t* d, uintptr_t n) { return dev.tx(id, d, n); }));
+    hand.setCanRxCallback(correlator.wrapRx([&dev](uint32_t* id, uint8_t* d, uint8_t* n) { return dev.rx(id, d, n); }));
+
+    api::AsyncHand async(hand, std::chrono::milliseconds(50));
+    async.setPipeline(&correlator, model, side);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // 一批三个通道：各自的新值，请求帧只经关联器发出一次
+    dev.set(77);
+    const auto before = correlator.stats();
+    auto pos = async.requestPosition();
+    auto speed = async.requestSpeed();
+    auto torque = async.requestTorque();
+    const auto p = pos.get();
+    const auto s = speed.get();
+    const auto t = torque.get();
+    const auto batch = correlator.stats();
+    expect(allEqual(p, 10, 77) && allEqual(s, 10, 77) && allEqual(t, 10, 77), "batched reads return fresh values");
+    expect(batch.requests - before.requests == 6 && batch.matched - before.matched == 6,
+           "one request per frame, all matched");
+
+    // 设备值变化后再读：拿到的是这次的应答，而不是 SDK 缓存里的旧值
+    dev.set(88);
+    expect(allEqual(async.requestPosition().get(), 10, 88), "second read is not the stale cache");
+
+    // L10 的手指触觉同样走关联器（每指一帧应答）
+    const auto force = async.requestForce().get();
+    expect(force.size() == 5, "force resolves on the pipelined path");
+
+    // 缺一帧应答：整次读取以 Timeout 失败，不返回旧缓存
+    {
+        std::lock_guard<std::mutex> lk(dev.mutex);
+        dev.drop.insert(0x04);
+    }
+    bool timed_out = false;
+    try {
+        async.requestPosition().get();
+    } catch (const HandException& e) {
+        timed_out = e.error_code() == HandError::Timeout;
+    }
+    expect(timed_out, "missing reply fails with Timeout");
+    {
+        std::lock_guard<std::mutex> lk(dev.mutex);
+        dev.drop.clear();
+    }
+
+    // 回调版本
+    std::promise<bool> done;
+    async.requestTemperature([&done](const api::AsyncHand::Bytes& v, std::exception_ptr e) {
+        done.set_value(!e && allEqual(v, 10, 88));
+    });
+    auto done_future = done.get_future();
+    expect(done_future.wait_for(std::chrono::seconds(1)) == std::future_status::ready && done_future.get(),
+           "completion callback receives the value");
+
+    // 写指令按序执行，经 SDK 发送队列写出
+    std::vector<uint8_t> pose(10);
+    for (size_t i = 0; i < pose.size(); ++i) pose[i] = static_cast<uint8_t>(100 + i);
+    async.setPosition(pose).get();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    bool wrote = false;
+    {
+        std::lock_guard<std::mutex> lk(dev.mutex);
+        for (const auto& w : dev.writes) wrote = wrote || (w.size() >= 2 && w[0] == 0x01 && w[1] == 100);
+    }
+    expect(wrote, "setPosition reaches the bus");
+
+    std::printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    std::fflush(stdout);
+    // SDK 内部线程在析构时可能等待设备应答，检查结束后直接退出
+    std::_Exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,80 @@
+// L10 / CAN / 右手 —— C++20 协程示例（需 -DBUILD_COROUTINE_EXAMPLES=ON，仅 Linux）
+//
+// 一个 EpollExecutor 线程同时跑两个协程：
+//   - control：co_await hand.position() 周期回读并下发位置；
+//   - sniff：另开一个 SocketCAN 套接字，co_await bus.recv() 旁路统计总线帧数。
+// 整个过程除 SDK 自身线程外不再创建任何线程。
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "_win_console_utf8.h"
+#include "LinkerHandApi.h"
+#include "CommFactory.h"
+#include "Coroutine.h"
+
+using namespace linkerhand::coro;
+
+static Task<void> control(EpollExecutor& ex, CoHand& hand)
+{
+    const std::vector<uint8_t> open_pose(10, 255);
+    const std::vector<uint8_t> fist_pose = {100, 40, 0, 0, 0, 0, 255, 255, 255, 80};
+
+    std::cout << "version: " << co_await hand.version() << std::endl;
+    for (int i = 0; i < 10; ++i) {
+        hand.setPosition(i % 2 ? fist_pose : open_pose);
+        co_await ex.sleep_for(std::chrono::milliseconds(500));
+
+        std::vector<uint8_t> pos = co_await hand.position();
+        std::cout << "position:";
+        for (uint8_t v : pos) std::cout << ' ' << static_cast<int>(v);
+        std::cout << std::endl;
+    }
+    ex.stop();
+}
+
+static Task<void> sniff(CoCanSocket& bus, size_t& frames)
+{
+    while (true) {
+        Communication::CanFDFrame f = co_await bus.recv();
+        (void)f;
+        ++frames;
+    }
+}
+
+int main() {
+    try {
+        LinkerHandApi api(LINKER_HAND::L10, HAND_TYPE::RIGHT);
+        std::shared_ptr<Communication::ICanBus> bus = Communication::CommFactory::createCanBus("can0", 1000000);
+
+        api.setCanTxCallback([bus](uint32_t can_id, const uint8_t* data, uintptr_t data_len) -> int32_t {
+            bus->send(std::vector<uint8_t>(data, data + data_len), can_id);
+            return 0;
+        });
+        api.setCanRxCallback([bus](uint32_t* can_id_out, uint8_t* data_out, uint8_t* len_out) -> int32_t {
+            auto frame = bus->recv();
+            if (frame.can_id == 0 && frame.can_dlc == 0) {
+                return -1;
+            }
+            *can_id_out = frame.can_id;
+            *len_out = frame.can_dlc;
+            memcpy(data_out, frame.data, frame.can_dlc);
+            return 0;
+        });
+
+        EpollExecutor ex;
+        CoHand hand(ex, api);
+        CoCanSocket raw(ex, "can0");
+        size_t frames = 0;
+
+        ex.spawn(control(ex, hand));
+        ex.spawn(sniff(raw, frames));
+        ex.run();
+
+        std::cout << "frames seen on can0: " << frames << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,205 @@
+// 多手管理器检查：以 IFrameLink 测试替身（eventfd 驱动的内存链路）接入三只 L10，断言
+//   - 各手的回读调度器由管理器的事件循环驱动，拿到的是各自链路上的应答；
+//   - 同一总线上的手平分回读预算；
+//   - 接收队列溢出计入 rx_dropped，链路写失败计入 tx_errors；
+//   - stop() 之后事件循环不再取帧。
+// 无需硬件，失败时返回非 0（已登记为 ctest 用例 hand_manager）。
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "HandManager.h"
+
+using namespace linkerhand;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool ok, const char* what)
+{
+    std::printf("%-48s %s\n", what, ok ? "ok" : "FAILED");
+    if (!ok) ++failures;
+}
+
+// 测试替身：单字节读请求回显命令字，其余字节填 value；eventfd 计数非零即有帧待取
+class FakeLink : public communication::IFrameLink
+{
+public:
+    std::atomic<uint8_t> value{0};
+    std::atomic<bool> fail_writes{false};
+
+    FakeLink() : efd_(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {}
+    ~FakeLink() override { ::close(efd_); }
+
+    int fd() const override { return efd_; }
+
+    size_t drain(const communication::FrameSink& sink, size_t max_frames) override
+    {
+        size_t n = 0;
+        while (n < max_frames) {
+            Frame f;
+            {
+                std::lock_guard<std::mutex> lk(mutex_);
+                if (queue_.empty()) {
+                    uint64_t v = 0;
+                    ssize_t r = ::read(efd_, &v, sizeof(v));  // 取空后清除可读状态
+                    (void)r;
+                    break;
+                }
+                f = queue_.front();
+                queue_.pop_front();
+            }
+            sink(f.id, f.data, f.len);
+            ++n;
+        }
+        return n;
+    }
+
+    bool write(uint32_t can_id, const uint8_t* data, size_t len) override
+    {
+        if (fail_writes) return false;
+        if (len == 1) {
+            uint8_t d[8];
+            std::memset(d, value.load(), sizeof(d));
+            d[0] = data[0];
+            inject(can_id, d, sizeof(d));
+        }
+        return true;
+    }
+
+    // 模拟总线上到达一帧
+    void inject(uint32_t can_id, const uint8_t* data, uint8_t len)
+    {
+        Frame f;
+        f.id = can_id;
+        f.len = len;
+        std::memcpy(f.data, data, len);
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            queue_.push_back(f);
+        }
+        const uint64_t one = 1;
+        ssize_t r = ::write(efd_, &one, sizeof(one));
+        (void)r;
+    }
+
+private:
+    struct Frame {
+        uint32_t id = 0;
+        uint8_t  len = 0;
+        uint8_t  data[8];
+    };
+
+    int efd_;
+    std::mutex mutex_;
+    std::deque<Frame> queue_;
+};
+
+// 等调度器发布的位置全部等于 value（最多 2s）
+bool waitPosition(api::PollScheduler& poller, uint8_t value)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    std::vector<uint8_t> v;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (poller.latest(api::PollChannel::Position, v) && v.size() == 10) {
+            bool all = true;
+            for (uint8_t b : v) all = all && b == value;
+            if (all) return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+template <typename Pred>
+bool waitFor(Pred pred)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (!pred() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return pred();
+}
+
+}  // namespace
+
+int main()
+{
+    api::HandManagerConfig cfg;
+    cfg.poll_workers = 2;
+    cfg.rx_queue = 8;
+    cfg.bus_utilization = 0.02;
+    api::HandManager mgr(cfg);
+    expect(mgr.threadCount() == 3, "one rx worker plus two poll workers");
+
+    bool threw = false;
+    try {
+        mgr.addHand(L10, HAND_TYPE::RIGHT, nullptr, "bus0");
+    } catch (const InvalidParameterException&) {
+        threw = true;
+    }
+    expect(threw, "addHand rejects a null link");
+
+    // 两只回读的手共用 bus0，第三只不回读、独占 bus1
+    FakeLink* a = new FakeLink;
+    FakeLink* b = new FakeLink;
+    FakeLink* c = new FakeLink;
+    a->value = 40;
+    b->value = 60;
+    const size_t ia = mgr.addHand(L10, HAND_TYPE::RIGHT, std::unique_ptr<communication::IFrameLink>(a), "bus0");
+    const size_t ib = mgr.addHand(L10, HAND_TYPE::LEFT, std::unique_ptr<communication::IFrameLink>(b), "bus0");
+    const size_t ic = mgr.addHand(L10, HAND_TYPE::RIGHT, std::unique_ptr<communication::IFrameLink>(c), "bus1", false);
+    expect(mgr.size() == 3 && mgr.linkCount() == 3 && mgr.poller(ic) == nullptr, "three hands on three links");
+
+    expect(waitPosition(*mgr.poller(ia), 40) && waitPosition(*mgr.poller(ib), 60),
+           "each poller sees its own link's replies");
+    const double share = cfg.bus_utilization / 2;
+    expect(mgr.poller(ia)->scheduledUtilization() <= share + 1e-9
+               && mgr.poller(ib)->scheduledUtilization() <= share + 1e-9,
+           "hands on one bus split the poll budget");
+    const api::HandLinkStats sa = mgr.stats(ia);
+    expect(sa.rx_frames > 0 && sa.tx_frames > 0 && sa.tx_errors == 0 && sa.rx_dropped == 0, "link stats count traffic");
+
+    // 一次涌入远超队列容量的帧：全部计入 rx_frames，溢出的计入 rx_dropped
+    const uint64_t rx_before = mgr.stats(ic).rx_frames;
+    const uint8_t reply[8] = {0x01, 1, 2, 3, 4, 5, 6, 0};
+    for (int i = 0; i < 500; ++i) c->inject(static_cast<uint32_t>(HAND_TYPE::RIGHT), reply, sizeof(reply));
+    expect(waitFor([&] { return mgr.stats(ic).rx_frames - rx_before == 500; }) && mgr.stats(ic).rx_dropped > 0,
+           "queue overflow counts as rx_dropped");
+
+    // 链路写失败：经 SDK 发送队列的写指令计入 tx_errors
+    c->fail_writes = true;
+    mgr.hand(ic).setPosition(std::vector<uint8_t>(10, 128));
+    expect(waitFor([&] { return mgr.stats(ic).tx_errors > 0; }), "failed writes count as tx_errors");
+
+    threw = false;
+    try {
+        mgr.hand(3);
+    } catch (const InvalidParameterException&) {
+        threw = true;
+    }
+    expect(threw, "hand() rejects an out-of-range index");
+
+    // 停止后链路上的帧留在原处，不再分发
+    mgr.stop();
+    const uint64_t rx_stopped = mgr.stats(ia).rx_frames;
+    a->inject(static_cast<uint32_t>(HAND_TYPE::RIGHT), reply, sizeof(reply));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    expect(mgr.stats(ia).rx_frames == rx_stopped, "stop() halts the event loops");
+
+    std::printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    std::fflush(stdout);
+    // SDK 内部线程在析构时可能等待设备应答，检查结束后直接退出
+    std::_Exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
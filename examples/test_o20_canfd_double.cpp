@@ -10,6 +10,8 @@
 //   4. HAND_TYPE 传错也没关系：O20Hand 会在 setCanRxCallback 时主动探测
 //      固件自报手型，与传入不一致时静默校正 device_id 并在 stdout 打印
 //      "[LinkerHand O20] ⚠ 手型自动校正: ..." 提示。
+//   5. 双手动作需同时生效时，经 SyncDispatcher 暂存两手的指令再一起放行，
+//      两块适配器各占一个 lane；放行报告给出实测的两手偏差。
 // -----------------------------------------------------------------------------
 #include <iostream>
 #include <vector>
@@ -20,6 +22,7 @@
 #include "LinkerHandApi.h"
 #include "CommunicationCallbacks.h"
 #include "CanFD.h"
+#include "SyncDispatch.h"
 
 namespace {
 
@@ -32,7 +35,7 @@ struct HandRuntime {
         : canfd(dev_num, 0), label(lbl) {}
 };
 
-bool bringUp(HandRuntime& hand, HAND_TYPE side) {
+bool bringUp(HandRuntime& hand, HAND_TYPE side, linkerhand::api::SyncDispatcher& sync, unsigned lane) {
     if (!hand.canfd.init()) {
         std::cerr << "[" << hand.label << "] Failed to initialize CANFD" << std::endl;
         return false;
@@ -57,7 +60,7 @@ bool bringUp(HandRuntime& hand, HAND_TYPE side) {
         return -1;
     };
 
-    hand.api->setCanTxCallback(tx);
+    hand.api->setCanTxCallback(sync.txCallback(sync.addHand(tx, lane)));
     hand.api->setCanRxCallback(rx);
     return true;
 }
@@ -67,13 +70,14 @@ bool bringUp(HandRuntime& hand, HAND_TYPE side) {
 int main() {
     std::cout << "O20 CANFD Double-Hand Test" << std::endl;
 
+    linkerhand::api::SyncDispatcher sync;  // 须比两只手的 api 活得久
     HandRuntime right(0, "RIGHT");
     HandRuntime left (1, "LEFT ");
 
-    if (!bringUp(right, HAND_TYPE::RIGHT)) {
+    if (!bringUp(right, HAND_TYPE::RIGHT, sync, 0)) {
         return 1;
     }
-    if (!bringUp(left, HAND_TYPE::LEFT)) {
+    if (!bringUp(left, HAND_TYPE::LEFT, sync, 1)) {
         right.canfd.close();
         return 1;
     }
@@ -86,8 +90,11 @@ int main() {
         std::cout << "[LEFT ] Version: " << left.api->getVersion() << std::endl;
 
         std::vector<uint8_t> pos(34, 0);
-        right.api->setPosition(pos);
-        left.api->setPosition(pos);
+        sync.stage(0, [&] { right.api->setPosition(pos); });
+        sync.stage(1, [&] { left.api->setPosition(pos); });
+        const auto report = sync.release();
+        std::cout << "Sync dispatch: " << report.frames << " frames, skew "
+                  << report.skew_ns / 1000.0 << " us" << (report.complete ? "" : " (incomplete)") << std::endl;
 
         std::this_thread::sleep_for(std::chrono::seconds(1));
 
@@ -0,0 +1,136 @@
+// 回读时间戳检查：模拟一只 L10 应答位置请求，由 processEvents() 驱动 PollScheduler，断言
+// 通道样本只在收到新应答时发布、ChannelStamp::recv_ns 取 RX 路径上的应答到达时刻，
+// 设备不应答期间的轮询不产生重复样本，也不推送给订阅者。
+// 无需硬件，失败时返回非 0（已登记为 ctest 用例 poll_stamp）。
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "PollScheduler.h"
+
+using namespace linkerhand;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool ok, const char* what)
+{
+    std::printf("%-48s %s\n", what, ok ? "ok" : "FAILED");
+    if (!ok) ++failures;
+}
+
+int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 模拟设备：对单字节读请求回显命令字，muted 时不应答
+struct FakeHand {
+    std::mutex mutex;
+    std::deque<std::pair<uint32_t, std::vector<uint8_t>>> replies;
+    std::atomic<bool> muted{false};
+    std::atomic<int64_t> last_reply_ns{0};  // 最近一帧应答交给 RX 回调的时刻
+
+    int32_t tx(uint32_t can_id, const uint8_t* data, uintptr_t len)
+    {
+        if (len != 1 || muted) return 0;
+        std::vector<uint8_t> d(8, 50);
+        d[0] = data[0];
+        std::lock_guard<std::mutex> lk(mutex);
+        replies.emplace_back(can_id, std::move(d));
+        return 0;
+    }
+
+    int32_t rx(uint32_t* can_id, uint8_t* data, uint8_t* len)
+    {
+        std::unique_lock<std::mutex> lk(mutex);
+        if (replies.empty()) {
+            lk.unlock();
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            return -1;
+        }
+        const auto f = std::move(replies.front());
+        replies.pop_front();
+        lk.unlock();
+        *can_id = f.first;
+        std::memcpy(data, f.second.data(), f.second.size());
+        *len = static_cast<uint8_t>(f.second.size());
+        last_reply_ns = nowNs();
+        return 0;
+    }
+};
+
+// 按 processEvents() 驱动调度器约 ms 毫秒
+void drive(api::PollScheduler& poller, int ms)
+{
+    const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+    while (std::chrono::steady_clock::now() < end) {
+        poller.processEvents();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+}
+
+}  // namespace
+
+int main()
+{
+    const LINKER_HAND model = LINKER_HAND::L10;
+    FakeHand dev;
+    LinkerHandApi hand(model, HAND_TYPE::RIGHT);
+    api::PollScheduler poller(hand, model);
+    hand.setCanTxCallback([&dev](uint32_t id, const uint8_t* d, uintptr_t n) { return dev.tx(id, d, n); });
+    hand.setCanRxCallback(poller.wrapRx([&dev](uint32_t* id, uint8_t* d, uint8_t* n) { return dev.rx(id, d, n); }));
+
+    for (size_t i = 0; i < api::kPollChannelCount; ++i) poller.setChannelRate(static_cast<api::PollChannel>(i), 0.0);
+    poller.setChannelRate(api::PollChannel::Position, 100.0);
+
+    std::atomic<uint64_t> pushed{0};
+    poller.subscriptions().subscribe(api::channelBit(api::PollChannel::Position),
+                                     [&pushed](api::PollChannel, const api::HandState&) { ++pushed; });
+
+    api::HandState st;
+    drive(poller, 200);
+    poller.getState(st);
+    const api::ChannelStamp live = st.stamp(api::PollChannel::Position);
+    const int64_t checked_ns = nowNs();
+    expect(live.sequence > 0 && st.position.count == 10, "samples published while the hand replies");
+    expect(pushed == live.sequence, "one push per sample");
+    expect(live.recv_ns > 0 && live.recv_ns <= checked_ns, "recv_ns taken from the RX path");
+
+    // 设备静默：轮询照常进行，但 SDK 缓存里是旧应答，不应产生新样本
+    dev.muted = true;
+    drive(poller, 50);  // 等在途应答收完
+    poller.getState(st);
+    const api::ChannelStamp quiet = st.stamp(api::PollChannel::Position);
+    const int64_t muted_ns = dev.last_reply_ns;
+    const uint64_t polls_before = poller.stats(api::PollChannel::Position).polls;
+    const uint64_t pushed_before = pushed;
+    drive(poller, 200);
+    poller.getState(st);
+    const api::ChannelStamp after = st.stamp(api::PollChannel::Position);
+    expect(poller.stats(api::PollChannel::Position).polls > polls_before, "polling continues while muted");
+    expect(after.sequence == quiet.sequence && after.recv_ns == quiet.recv_ns, "no duplicate samples while muted");
+    expect(pushed == pushed_before, "no pushes while muted");
+    expect(quiet.recv_ns >= muted_ns - 1000000 && quiet.recv_ns <= muted_ns + 1000000,
+           "last sample stamped at its reply");
+
+    dev.muted = false;
+    const int64_t resumed_ns = nowNs();
+    drive(poller, 100);
+    poller.getState(st);
+    const api::ChannelStamp resumed = st.stamp(api::PollChannel::Position);
+    expect(resumed.sequence > after.sequence && resumed.recv_ns >= resumed_ns, "new replies publish again");
+
+    std::printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    std::fflush(stdout);
+    // SDK 内部线程在析构时可能等待设备应答，检查结束后直接退出
+    std::_Exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
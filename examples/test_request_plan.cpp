@@ -0,0 +1,90 @@
+// 读请求命令表检查：按 readRequestFrames() 发出每个型号的一轮手指触觉请求，按 tactileLayout() 的
+// 形状逐帧喂入应答，断言 RequestCorrelator 恰好在最后一帧收齐每个请求、TactileBuffer 发布一个完整帧，
+// 且 defaultPollChannelCost() 的帧数与命令表一致。
+// 无需硬件，失败时返回非 0（已登记为 ctest 用例 request_plan）。
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "PollScheduler.h"
+#include "RequestPlan.h"
+#include "TactileBuffer.h"
+
+using namespace linkerhand;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool ok, const char* model, const char* what)
+{
+    std::printf("%-4s %-48s %s\n", model, what, ok ? "ok" : "FAILED");
+    if (!ok) ++failures;
+}
+
+// 第 f 指第 r 行的应答帧（协议见 TactileBuffer.h）
+std::vector<uint8_t> fingerReply(LINKER_HAND model, uint8_t cmd, size_t r, const api::TactileLayout& layout)
+{
+    if (model == L7 || model == L10) return {cmd, 1, 2, 3, 4, 0, 0, 0};
+    std::vector<uint8_t> d(layout.cols + 2, 7);
+    d[0] = cmd;
+    d[1] = static_cast<uint8_t>(r << 4);
+    return d;
+}
+
+void checkModel(LINKER_HAND model, const char* name)
+{
+    const uint32_t can_id = static_cast<uint32_t>(HAND_TYPE::RIGHT);
+    const auto plan = api::readRequestFrames(model, api::PollChannel::Force);
+    const api::TactileLayout layout = api::tactileLayout(model);
+
+    communication::RequestCorrelator correlator;
+    correlator.setReplyCounter(api::requestReplyCounter(model));
+    api::TactileBuffer tactile(model, HAND_TYPE::RIGHT);
+
+    expect(plan.size() == layout.fingers, name, "one request per finger");
+    std::vector<communication::RequestCorrelator::Ticket> tickets;
+    for (const auto& f : plan) {
+        tactile.onTx(can_id, f.data, f.len);
+        tickets.push_back(correlator.onTx(can_id, f.data, f.len));
+    }
+
+    bool early = false;
+    for (size_t i = 0; i < plan.size(); ++i) {
+        for (size_t r = 0; r < layout.rows; ++r) {
+            // 每个请求都应在本指最后一行到达前保持在途
+            early = early || correlator.inFlight() != plan.size() - i;
+            const auto d = fingerReply(model, plan[i].data[0], r, layout);
+            correlator.onRx(can_id, d.data(), d.size());
+            tactile.onRx(can_id, d.data(), d.size());
+        }
+    }
+
+    bool answered = !tickets.empty();
+    for (auto t : tickets) answered = answered && t != 0 && correlator.wait(t, std::chrono::milliseconds(0));
+    const auto st = correlator.stats();
+    expect(!early, name, "requests stay in flight until their last row");
+    expect(answered && st.in_flight == 0, name, "every request answered");
+    expect(st.unmatched == 0 && st.timeouts == 0, name, "no unmatched or expired replies");
+    expect(tactile.stats().frames == 1 && tactile.stats().incomplete == 0, name, "one complete tactile frame");
+
+    // 回读调度的帧开销估算与命令表同源
+    size_t replies = 0;
+    for (const auto& f : plan) replies += f.replies;
+    const auto cost = api::defaultPollChannelCost(model, api::PollChannel::Force);
+    expect(cost.tx_frames == plan.size() && cost.rx_frames == replies, name, "poll cost matches the request plan");
+}
+
+}  // namespace
+
+int main()
+{
+    checkModel(LINKER_HAND::L6, "L6");
+    checkModel(LINKER_HAND::O6, "O6");
+    checkModel(LINKER_HAND::L7, "L7");
+    checkModel(LINKER_HAND::L10, "L10");
+    checkModel(LINKER_HAND::L21, "L21");
+    checkModel(LINKER_HAND::L25, "L25");
+    std::printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,197 @@
+// 实时控制面检查：装上 core/RtCheck.h 的钩子，断言 RtHand 热路径不分配内存、不加锁，
+// 且发送线程写出的位置帧与 LinkerHandApi::setPosition 对同一位姿发出的帧逐字节一致。
+// 无需硬件：发送经回调截获，触觉帧直接注入 TactileBuffer。失败时返回非 0（已登记为 ctest 用例 rt_check）。
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "RtControl.h"
+#include "RtCheck.h"
+
+LINKERHAND_RT_CHECK_HOOKS()
+
+using namespace linkerhand;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool ok, const char* what)
+{
+    std::printf("%-48s %s\n", what, ok ? "ok" : "FAILED");
+    if (!ok) ++failures;
+}
+
+// 区间内的计数快照：先取快照再打印，打印本身的分配不计入被测区间
+struct Counts {
+    unsigned long long allocs = 0;
+    unsigned long long locks = 0;
+};
+
+Counts snapshot(const rtcheck::RtSection& s)
+{
+    return Counts{static_cast<unsigned long long>(s.allocations()), static_cast<unsigned long long>(s.locks())};
+}
+
+void expectClean(const Counts& c, const char* what)
+{
+    char line[96];
+    std::snprintf(line, sizeof(line), "%s (allocs %llu, locks %llu)", what, c.allocs, c.locks);
+    expect(c.allocs == 0 && c.locks == 0, line);
+}
+
+// 截获一路 TX 回调写出的帧（在发送线程或 SDK 发送线程执行，不在被测区间内）
+struct TxCapture {
+    std::mutex mutex;
+    std::vector<api::RtFrame> frames;
+
+    CanTxCallback callback()
+    {
+        return [this](uint32_t id, const uint8_t* data, uintptr_t len) -> int32_t {
+            if (len > sizeof(api::RtFrame::data)) return -1;
+            api::RtFrame f;
+            f.id = id;
+            f.len = static_cast<uint8_t>(len);
+            std::memcpy(f.data, data, len);
+            std::lock_guard<std::mutex> lk(mutex);
+            frames.push_back(f);
+            return 0;
+        };
+    }
+
+    // 等到连续 settle 内没有新帧（最多 500ms），返回截获的帧
+    std::vector<api::RtFrame> settle(std::chrono::milliseconds settle = std::chrono::milliseconds(50))
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+        size_t seen = 0;
+        auto last = std::chrono::steady_clock::now();
+        for (;;) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            std::lock_guard<std::mutex> lk(mutex);
+            const auto now = std::chrono::steady_clock::now();
+            if (frames.size() != seen) {
+                seen = frames.size();
+                last = now;
+            }
+            if ((seen > 0 && now - last >= settle) || now >= deadline) return frames;
+        }
+    }
+};
+
+bool sameFrames(const std::vector<api::RtFrame>& a, const std::vector<api::RtFrame>& b)
+{
+    if (a.empty() || a.size() != b.size()) return false;
+    for (size_t k = 0; k < a.size(); ++k) {
+        if (a[k].id != b[k].id || a[k].len != b[k].len || std::memcmp(a[k].data, b[k].data, a[k].len) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 注入一轮完整的 L6 手指触觉应答（5 指 × 12 行，每行 6 个单元）
+void feedFingers(api::TactileBuffer& tactile, uint32_t can_id, uint8_t value)
+{
+    for (uint8_t f = 0; f < 5; ++f) {
+        for (uint8_t r = 0; r < 12; ++r) {
+            uint8_t d[8] = {static_cast<uint8_t>(0xb1 + f), static_cast<uint8_t>(r << 4),
+                            value, value, value, value, value, value};
+            tactile.onRx(can_id, d, sizeof(d));
+        }
+    }
+}
+
+}  // namespace
+
+int main()
+{
+    const LINKER_HAND model = LINKER_HAND::L6;
+    const HAND_TYPE side = HAND_TYPE::RIGHT;
+
+    expect(rtcheck::hooksInstalled(), "hooks installed");
+    {
+        // 对照：钩子确实能计到一次分配和一次加锁
+        rtcheck::RtSection s;
+        std::mutex m;
+        m.lock();
+        m.unlock();
+        delete new int(1);
+        expect(s.allocations() == 1 && s.locks() == 1, "control section counts allocation and lock");
+    }
+
+    LinkerHandApi hand(model, side);
+    hand.setCanTxCallback([](uint32_t, const uint8_t*, uintptr_t) { return 0; });
+    api::PollScheduler poller(hand, model);
+    api::TactileBuffer tactile(model, side);
+    api::RtHand rt(model, side, &poller, &tactile);
+    TxCapture sent;
+    rt.startSender(sent.callback());
+
+    feedFingers(tactile, static_cast<uint32_t>(side), 42);
+
+    uint8_t pose[32] = {};
+    for (size_t i = 0; i < rt.dof(); ++i) pose[i] = static_cast<uint8_t>(100 + i);
+    uint8_t cells[1024] = {};
+    api::HandState state;
+    unsigned peak = 0;
+    std::error_code set_ok, set_bad, get_state, fingers, tactile_read;
+    Counts c_set, c_bad, c_state, c_fingers, c_read;
+
+    {
+        rtcheck::RtSection s;
+        set_ok = rt.setPosition(pose, rt.dof());
+        c_set = snapshot(s);
+    }
+    {
+        rtcheck::RtSection s;
+        set_bad = rt.setPosition(pose, rt.dof() + 1);
+        c_bad = snapshot(s);
+    }
+    {
+        rtcheck::RtSection s;
+        get_state = rt.getState(state);
+        c_state = snapshot(s);
+    }
+    {
+        rtcheck::RtSection s;
+        fingers = rt.copyFingers(cells, sizeof(cells));
+        c_fingers = snapshot(s);
+    }
+    {
+        rtcheck::RtSection s;
+        tactile_read = rt.readTactile([&](const api::TactileView& v) noexcept { peak = v.at(4, 11, 5); });
+        c_read = snapshot(s);
+    }
+
+    expectClean(c_set, "setPosition");
+    expectClean(c_bad, "setPosition (rejected)");
+    expectClean(c_state, "getState");
+    expectClean(c_fingers, "copyFingers");
+    expectClean(c_read, "readTactile");
+    expect(!set_ok, "setPosition succeeds");
+    expect(set_bad == make_error_code(HandError::InvalidParameter), "setPosition rejects wrong size");
+    // 无硬件时尚无回读，返回 InvalidState
+    expect(!get_state || get_state == make_error_code(HandError::InvalidState), "getState returns");
+    expect(!fingers && cells[0] == 42, "copyFingers returns the injected frame");
+    expect(!tactile_read && peak == 42, "readTactile sees the injected frame");
+
+    // 对照：同一位姿经 SDK 发送队列写出的帧
+    const std::vector<api::RtFrame> rt_frames = sent.settle();
+    TxCapture reference;
+    LinkerHandApi sdk(model, side);
+    sdk.setCanTxCallback(reference.callback());
+    sdk.setPosition(std::vector<uint8_t>(pose, pose + rt.dof()));
+    expect(sameFrames(rt_frames, reference.settle()), "sender frames match LinkerHandApi::setPosition");
+
+    rt.stopSender();
+    expect(rt.stats().commands == 1 && rt.stats().rejected == 1, "one command accepted, one rejected");
+    std::printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    std::fflush(stdout);
+    // SDK 内部线程在析构时可能等待设备应答，检查结束后直接退出
+    std::_Exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,196 @@
+// 会话录制往返检查：SessionRecorder 录下一只模拟 L10 的收发帧与位置样本，再断言
+//   - SessionDataset 读出同样的样本行与收发帧数；
+//   - ReplayLog::fromSession() 与 exportCandump() → fromCandump() 得到同一帧序列；
+//   - ReplayCanBus 尽快回放给新的 LinkerHandApi 后，其缓存的位置即录制时最后的应答。
+// 无需硬件，失败时返回非 0（已登记为 ctest 用例 session）。
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "LinkerHandApi.h"
+#include "SessionDataset.h"
+#include "SessionReplay.h"
+
+using namespace linkerhand;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool ok, const char* what)
+{
+    std::printf("%-48s %s\n", what, ok ? "ok" : "FAILED");
+    if (!ok) ++failures;
+}
+
+// 模拟设备：单字节读请求回显命令字，其余字节填 value
+struct FakeHand {
+    std::mutex mutex;
+    std::deque<std::pair<uint32_t, std::vector<uint8_t>>> replies;
+    std::atomic<uint8_t> value{0};
+    std::atomic<size_t> tx_frames{0};
+    std::atomic<size_t> rx_frames{0};
+
+    int32_t tx(uint32_t can_id, const uint8_t* data, uintptr_t len)
+    {
+        ++tx_frames;
+        if (len != 1) return 0;
+        std::vector<uint8_t> d(8, value.load());
+        d[0] = data[0];
+        std::lock_guard<std::mutex> lk(mutex);
+        replies.emplace_back(can_id, std::move(d));
+        return 0;
+    }
+
+    int32_t rx(uint32_t* can_id, uint8_t* data, uint8_t* len)
+    {
+        std::unique_lock<std::mutex> lk(mutex);
+        if (replies.empty()) {
+            lk.unlock();
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            return -1;
+        }
+        const auto f = std::move(replies.front());
+        replies.pop_front();
+        lk.unlock();
+        *can_id = f.first;
+        std::memcpy(data, f.second.data(), f.second.size());
+        *len = static_cast<uint8_t>(f.second.size());
+        ++rx_frames;
+        return 0;
+    }
+};
+
+bool allEqual(const std::vector<uint8_t>& v, uint8_t value)
+{
+    if (v.size() != 10) return false;
+    for (uint8_t b : v) {
+        if (b != value) return false;
+    }
+    return true;
+}
+
+// 轮询 getter 直到缓存里是 value（最多 500ms）
+std::vector<uint8_t> readUntil(LinkerHandApi& hand, uint8_t value)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+    std::vector<uint8_t> v = hand.getPosition();
+    while (!allEqual(v, value) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        v = hand.getPosition();
+    }
+    return v;
+}
+
+// candump -L 不带方向，时间为微秒级墙钟：比对 ID、载荷与相对首帧的时间（允许 1us 舍入）
+bool sameFrames(const api::ReplayLog& a, const api::ReplayLog& b)
+{
+    if (a.empty() || a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        const int64_t dt = (a[i].t_ns - a[0].t_ns) - (b[i].t_ns - b[0].t_ns);
+        if (a[i].id != b[i].id || a[i].len != b[i].len || dt > 1000 || dt < -1000
+            || std::memcmp(a.data(a[i]), b.data(b[i]), a[i].len) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main()
+{
+    const LINKER_HAND model = LINKER_HAND::L10;
+    // 按进程号区分文件名，并行运行的多份用例互不覆盖
+    const std::string file = "test_session." + std::to_string(::getpid()) + ".lhrs";
+    const char* path = file.c_str();
+    const uint8_t values[] = {11, 22, 33};
+    std::vector<std::vector<uint8_t>> recorded;
+
+    FakeHand dev;
+    {
+        api::SessionRecorder rec(path);
+        LinkerHandApi hand(model, HAND_TYPE::RIGHT);
+        hand.setCanTxCallback(rec.wrapTx([&dev](uint32_t id, const uint8_t* d, uintptr_t n) { return dev.tx(id, d, n); }));
+        hand.setCanRxCallback(rec.wrapRx([&dev](uint32_t* id, uint8_t* d, uint8_t* n) { return dev.rx(id, d, n); }));
+
+        api::HandState st;
+        for (uint8_t v : values) {
+            dev.value = v;
+            const auto pos = readUntil(hand, v);
+            recorded.push_back(pos);
+            st.position.count = static_cast<uint8_t>(pos.size());
+            std::memcpy(st.position.values, pos.data(), pos.size());
+            st.stamps[static_cast<size_t>(api::PollChannel::Position)].recv_ns = api::SessionRecorder::now();
+            rec.recordState(api::PollChannel::Position, st);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));  // 等在途应答录完
+        hand.setCanTxCallback([](uint32_t, const uint8_t*, uintptr_t) { return 0; });
+        hand.setCanRxCallback([](uint32_t*, uint8_t*, uint8_t*) -> int32_t {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return -1;
+        });
+        rec.close();
+        expect(rec.stats().dropped == 0 && rec.stats().write_errors == 0, "recorded without drops");
+    }
+    bool fresh = true;
+    for (size_t i = 0; i < recorded.size(); ++i) fresh = fresh && allEqual(recorded[i], values[i]);
+    expect(fresh, "simulated hand answered every value");
+
+    // 数据集：样本列与收发帧列
+    {
+        api::SessionDataset ds(path);
+        const auto& pos = ds.channel(api::PollChannel::Position);
+        bool rows = pos.size() == recorded.size() && pos.rowBytes() == 10;
+        for (size_t i = 0; rows && i < pos.size(); ++i) {
+            rows = std::memcmp(pos.row(i), recorded[i].data(), 10) == 0 && (i == 0 || pos.time(i) > pos.time(i - 1));
+        }
+        expect(rows, "dataset rows match the recorded samples");
+        expect(ds.frames(api::SessionRecordType::CanTx).size() == dev.tx_frames
+                   && ds.frames(api::SessionRecordType::CanRx).size() == dev.rx_frames,
+               "dataset frame columns match the bus traffic");
+        expect(ds.corruptChunks() == 0 && ds.droppedRecords() == 0, "no corrupt chunks");
+    }
+
+    // 回放日志：会话文件与导出的 candump 得到同一帧序列
+    const auto log = std::make_shared<api::ReplayLog>(api::ReplayLog::fromSession(path));
+    size_t tx = 0;
+    for (size_t i = 0; i < log->size(); ++i) tx += ((*log)[i].flags & api::kReplayTx) ? 1 : 0;
+    expect(log->size() == dev.tx_frames + dev.rx_frames && tx == dev.tx_frames, "fromSession keeps every frame");
+    std::ostringstream dump;
+    {
+        api::SessionReader reader(path);
+        api::exportCandump(reader, dump);
+    }
+    std::istringstream dump_in(dump.str());
+    expect(sameFrames(*log, api::ReplayLog::fromCandump(dump_in)), "candump export parses back to the same frames");
+
+    // 尽快回放给一只新的手：SDK 缓存应停在最后一次应答
+    api::ReplayConfig cfg;
+    cfg.pace = api::ReplayPace::AsFastAsPossible;
+    api::ReplayCanBus bus(log, cfg);
+    LinkerHandApi replay(model, HAND_TYPE::RIGHT);
+    replay.setCanTxCallback(bus.txCallback());
+    replay.setCanRxCallback(bus.rxCallback());
+    const bool finished = bus.engine().waitFinished(std::chrono::seconds(2));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    expect(finished && bus.stats().delivered == dev.rx_frames, "replay delivers every received frame");
+    expect(allEqual(replay.getPosition(), values[2]), "replayed hand ends on the last reply");
+
+    std::remove(path);
+    std::printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    std::fflush(stdout);
+    // SDK 内部线程在析构时可能等待设备应答，检查结束后直接退出
+    std::_Exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
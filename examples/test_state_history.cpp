@@ -0,0 +1,114 @@
+// 状态历史检查：按已知序列写入 StateHistory，断言同一样本序号只记一次、窗口统计（均值 / 标准差 /
+// 最值 / 首尾 / 斜率）与手算一致、since() 按时间戳定位、环被覆盖后视图报告失效，
+// 以及经 StateSubscriptionHub 推送的样本同样入环。
+// 无需硬件，失败时返回非 0（已登记为 ctest 用例 state_history）。
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "StateHistory.h"
+
+using namespace linkerhand;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool ok, const char* what)
+{
+    std::printf("%-48s %s\n", what, ok ? "ok" : "FAILED");
+    if (!ok) ++failures;
+}
+
+bool near(double a, double b) { return std::fabs(a - b) < 1e-6; }
+
+constexpr int64_t kMs = 1000000;
+
+// 第 i 个位置样本：关节 0 每 100ms 增加 2（斜率 20/s），关节 1 恒为 50
+void positionSample(api::HandState& st, uint64_t i)
+{
+    st.position.count = 2;
+    st.position.values[0] = static_cast<uint8_t>(10 + 2 * i);
+    st.position.values[1] = 50;
+    auto& stamp = st.stamps[static_cast<size_t>(api::PollChannel::Position)];
+    stamp.sequence = i + 1;
+    stamp.recv_ns = static_cast<int64_t>(i) * 100 * kMs;
+}
+
+}  // namespace
+
+int main()
+{
+    api::HandState st;
+    api::StateHistory history(16, 4);
+
+    // 同一序号重复推送（例如其他通道触发的通知）只记一次；序号 0 表示尚无数据
+    history.record(api::PollChannel::Position, st);
+    for (uint64_t i = 0; i < 6; ++i) {
+        positionSample(st, i);
+        history.record(api::PollChannel::Position, st);
+        history.record(api::PollChannel::Position, st);
+    }
+    const auto& ring = history.joints(api::PollChannel::Position);
+    expect(ring.written() == 6, "one entry per sample sequence");
+
+    // 最近 300ms：t = 200..500ms，关节 0 为 14, 16, 18, 20
+    api::WindowStats ws[2];
+    const size_t n = history.windowStats(api::PollChannel::Position, std::chrono::milliseconds(300), ws, 2);
+    expect(n == 4 && ws[0].count == 4, "window covers the last 300ms");
+    expect(near(ws[0].mean, 17.0) && near(ws[0].stddev, std::sqrt(5.0)), "mean and stddev");
+    expect(ws[0].min == 14 && ws[0].max == 20 && ws[0].first == 14 && ws[0].last == 20, "min / max / first / last");
+    expect(near(ws[0].slope, 20.0), "least-squares slope in units per second");
+    expect(near(ws[1].mean, 50.0) && near(ws[1].stddev, 0.0) && near(ws[1].slope, 0.0), "constant element");
+
+    const auto from = ring.since(250 * kMs);
+    expect(from.size() == 3 && from.front().t_ns == 300 * kMs && from.valid(), "since() finds the first sample");
+    const auto last = ring.latest(2);
+    expect(last.size() == 2 && last.back().value.values[0] == 20, "latest() ends on the newest sample");
+
+    // 覆盖：容量 4 的环只保留 3 个可读样本，旧视图在被覆盖后失效
+    api::TimeSeriesRing<api::JointSample> small(4);
+    api::JointSample js;
+    js.count = 1;
+    for (uint8_t i = 0; i < 3; ++i) {
+        js.values[0] = i;
+        small.push(i * kMs, js);
+    }
+    const auto old_view = small.latest(3);
+    expect(old_view.size() == 3 && old_view.valid(), "view valid before overwrite");
+    for (uint8_t i = 3; i < 6; ++i) {
+        js.values[0] = i;
+        small.push(i * kMs, js);
+    }
+    api::TimeSeriesRing<api::JointSample>::Entry copy[3];
+    expect(!old_view.valid() && !old_view.copyTo(copy), "view invalid after overwrite");
+    const auto fresh = small.latest(10);
+    expect(fresh.size() == 3 && fresh.front().value.values[0] == 3 && fresh.valid(), "latest() keeps capacity - 1");
+
+    // 单指通道与推送接入
+    api::StateSubscriptionHub hub;
+    history.attach(hub, api::channelBit(api::PollChannel::NormalForce));
+    st.normal.count = 5;
+    for (uint8_t f = 0; f < 5; ++f) st.normal.values[f] = static_cast<uint8_t>(f * 10);
+    auto& stamp = st.stamps[static_cast<size_t>(api::PollChannel::NormalForce)];
+    stamp.sequence = 1;
+    stamp.recv_ns = 42 * kMs;
+    hub.notify(api::PollChannel::NormalForce, st);
+    hub.notify(api::PollChannel::Position, st);  // 未订阅的通道不入环
+    const auto& normal = history.fingers(api::PollChannel::NormalForce);
+    expect(normal.written() == 1 && normal.latest(1).back().value.values[4] == 40, "hub pushes land in the ring");
+    expect(ring.written() == 6, "unsubscribed channels are ignored");
+    history.detach();
+
+    bool threw = false;
+    try {
+        history.fingers(api::PollChannel::Position);
+    } catch (const InvalidParameterException&) {
+        threw = true;
+    }
+    expect(threw, "fingers() rejects joint channels");
+
+    std::printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,103 @@
+// 流式轨迹检查：对 L10 以三种插值曲线各走一段两途经点轨迹，截获 SDK 写出的位置帧，断言设定点
+// 单调、无跳变、准确落在终点，静止保持阶段不再下发，且输出线程没有下发失败。
+// 无需硬件，失败时返回非 0（已登记为 ctest 用例 trajectory）。
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "TrajectoryStreamer.h"
+
+using namespace linkerhand;
+
+namespace {
+
+int failures = 0;
+
+void expect(bool ok, const char* profile, const char* what)
+{
+    std::printf("%-12s %-40s %s\n", profile, what, ok ? "ok" : "FAILED");
+    if (!ok) ++failures;
+}
+
+// 截获 L10 位置帧（命令字 0x01，data[1] 为第 0 个关节）
+struct PositionCapture {
+    std::mutex mutex;
+    std::vector<uint8_t> joint0;
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        joint0.clear();
+    }
+
+    std::vector<uint8_t> values()
+    {
+        std::lock_guard<std::mutex> lk(mutex);
+        return joint0;
+    }
+};
+
+void checkProfile(LinkerHandApi& hand, PositionCapture& cap, api::TrajectoryProfile profile, const char* name)
+{
+    api::TrajectoryConfig cfg;
+    cfg.rate_hz = 50;
+    cfg.profile = profile;
+    api::TrajectoryStreamer traj(hand, cfg);
+
+    cap.clear();
+    traj.start(api::TrajectoryStreamer::Pose(10, 0.0));
+    traj.appendAfter(std::chrono::milliseconds(200), api::TrajectoryStreamer::Pose(10, 100.0));
+    traj.appendAfter(std::chrono::milliseconds(200), api::TrajectoryStreamer::Pose(10, 200.0));
+    const bool idle = traj.waitIdle(std::chrono::seconds(2));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));  // 等 SDK 发送队列写完
+    const std::vector<uint8_t> sent = cap.values();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    const size_t after_idle = cap.values().size();
+
+    bool monotonic = !sent.empty();
+    int max_step = 0;
+    for (size_t i = 1; i < sent.size(); ++i) {
+        monotonic = monotonic && sent[i] >= sent[i - 1];
+        max_step = std::max(max_step, sent[i] - sent[i - 1]);
+    }
+    const auto st = traj.stats();
+    expect(idle && traj.pending() == 0, name, "all waypoints executed");
+    expect(traj.setpoint().size() == 10 && traj.setpoint()[0] == 200.0, name, "setpoint ends on the last waypoint");
+    expect(!sent.empty() && sent.back() == 200, name, "last frame reaches the target");
+    expect(monotonic && max_step <= 40, name, "frames rise monotonically without jumps");
+    expect(after_idle == sent.size(), name, "no frames while holding");
+    expect(st.ticks > 0 && st.emit_errors == 0 && !traj.lastError(), name, "no emit errors");
+    traj.stop();
+}
+
+}  // namespace
+
+int main()
+{
+    LinkerHandApi hand(LINKER_HAND::L10, HAND_TYPE::RIGHT);
+    PositionCapture cap;
+    hand.setCanTxCallback([&cap](uint32_t, const uint8_t* data, uintptr_t len) -> int32_t {
+        if (len >= 2 && data[0] == 0x01) {
+            std::lock_guard<std::mutex> lk(cap.mutex);
+            cap.joint0.push_back(data[1]);
+        }
+        return 0;
+    });
+    hand.setCanRxCallback([](uint32_t*, uint8_t*, uint8_t*) -> int32_t {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return -1;
+    });
+
+    checkProfile(hand, cap, api::TrajectoryProfile::Linear, "Linear");
+    checkProfile(hand, cap, api::TrajectoryProfile::Cubic, "Cubic");
+    checkProfile(hand, cap, api::TrajectoryProfile::MinimumJerk, "MinimumJerk");
+
+    std::printf("%s\n", failures == 0 ? "PASS" : "FAIL");
+    std::fflush(stdout);
+    // SDK 内部线程在析构时可能等待设备应答，检查结束后直接退出
+    std::_Exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
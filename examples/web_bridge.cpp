@@ -12,7 +12,7 @@
 //            modbus：串口路径（如 /dev/ttyUSB0），留空按 side 自动探测。
 //
 // stdin 命令（空白分隔，每行一条）：
-//   P v0..vN   -> setPosition   （N 个 0..255，长度须 = DOF）
+//   P v0..vN   -> setPosition   （N 个 0..255，长度须 = DOF；同一轮的 P/S/T 合并为一次 setCommand）
 //   S v0..vN   -> setSpeed
 //   T v0..vN   -> setTorque
 //   R ch hz    -> 设置某通道回读频率（ch=pos|st|force|temp|fault，hz=1~100）
@@ -41,6 +41,7 @@
 #include <vector>
 
 #include "LinkerHandApi.h"
+#include "HandCommand.h"
 #include "CommFactory.h"
 #include "Modbus.h"
 #if defined(WEB_BRIDGE_HAS_CANFD)
@@ -235,9 +236,14 @@ int main(int argc, char** argv) {
             });
         }
 
-        // 保守初始化：中等速度/力矩，长度 = DOF。
-        hand->setSpeed(std::vector<uint8_t>(dof, 180));
-        hand->setTorque(std::vector<uint8_t>(dof, 180));
+        // 保守初始化：中等速度/力矩，长度 = DOF。之后 S/T 与上次相同则不再上总线。
+        linkerhand::api::CommandWriter writer(*hand);
+        {
+            linkerhand::api::HandCommand init;
+            init.speed.assign(dof, 180);
+            init.torque.assign(dof, 180);
+            writer.setCommand(init);
+        }
 
         // 版本串各字段以换行分隔；压进单行 JSON 用 ';' 保留字段边界（前端按 ';' 切段），引号替空格。
         auto sanitize = [](std::string v) {
@@ -282,6 +288,8 @@ int main(int argc, char** argv) {
         });
         reader.detach();
 
+        // 一轮排空内的 P/S/T 只保留各自最新值，合并成一次 setCommand 下发
+        linkerhand::api::HandCommand pending;
         auto apply = [&](const std::string& line) {
             std::istringstream ss(line);
             std::string cmd;
@@ -310,13 +318,9 @@ int main(int argc, char** argv) {
                 vals.push_back(static_cast<uint8_t>(x));
             }
             if ((int)vals.size() != dof) return;   // 长度不符直接丢弃
-            try {
-                if (cmd == "P") hand->setPosition(vals);
-                else if (cmd == "S") hand->setSpeed(vals);
-                else hand->setTorque(vals);
-            } catch (const std::exception& e) {
-                std::cerr << "BRIDGE_WARN: apply failed: " << e.what() << std::endl;
-            }
+            if (cmd == "P") pending.position = std::move(vals);
+            else if (cmd == "S") pending.speed = std::move(vals);
+            else pending.torque = std::move(vals);
         };
 
         // 主循环：5ms 轮询排空命令 + 时间戳驱动分频回读，各通道按各自周期上报。
@@ -333,6 +337,14 @@ int main(int argc, char** argv) {
                 local.swap(g_queue);
             }
             for (auto& ln : local) apply(ln);
+            if (!pending.position.empty() || !pending.speed.empty() || !pending.torque.empty()) {
+                try {
+                    writer.setCommand(pending);
+                } catch (const std::exception& e) {
+                    std::cerr << "BRIDGE_WARN: apply failed: " << e.what() << std::endl;
+                }
+                pending = linkerhand::api::HandCommand();
+            }
 
             now = clk::now();
             // 刚上电时设备信息可能晚到；未就绪则周期重试 getVersion，拿到后补发 META
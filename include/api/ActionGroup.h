@@ -0,0 +1,432 @@
+#ifndef LINKERHAND_ACTION_GROUP_H
+#define LINKERHAND_ACTION_GROUP_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "LinkerHandApi.h"
+#include "core/ThreadConfig.h"
+
+namespace linkerhand {
+namespace api {
+
+// 关键帧缓动：从上一帧姿态过渡到本帧姿态的方式
+enum class Easing : uint8_t {
+    Step,    // 帧开始即跳到目标并保持（与旧版 tick 状态机行为一致）
+    Linear,
+    Smooth   // 五次最小加加速度曲线
+};
+
+// 编译后的动作组：全部关键帧展平为连续数组，播放时只做二分查找与插值。
+struct ActionGroup {
+    LINKER_HAND model = L10;
+    uint8_t joints = 0;
+    std::vector<uint32_t> start_ms;     // 各帧起始时刻（累计）
+    std::vector<uint32_t> duration_ms;  // 各帧时长
+    std::vector<Easing>   easing;
+    std::vector<uint8_t>  poses;        // frames × joints，行优先
+
+    size_t frames() const { return duration_ms.size(); }
+    uint32_t totalMs() const { return frames() ? start_ms.back() + duration_ms.back() : 0; }
+    const uint8_t* pose(size_t frame) const { return poses.data() + frame * joints; }
+};
+
+inline const char* linkerHandName(LINKER_HAND m)
+{
+    switch (m) {
+        case L6:  return "L6";
+        case L7:  return "L7";
+        case L10: return "L10";
+        case L20: return "L20";
+        case L21: return "L21";
+        case L25: return "L25";
+        case O6:  return "O6";
+        case G20: return "G20";
+        case O20: return "O20";
+    }
+    return "?";
+}
+
+inline bool parseLinkerHandName(const std::string& s, LINKER_HAND& out)
+{
+    for (LINKER_HAND m : {L6, L7, L10, L20, L21, L25, O6, G20, O20}) {
+        if (s == linkerHandName(m)) {
+            out = m;
+            return true;
+        }
+    }
+    return false;
+}
+
+namespace detail {
+
+inline void appendFrame(ActionGroup& g, uint32_t duration, Easing e, const uint8_t* pose)
+{
+    g.start_ms.push_back(g.totalMs());
+    g.duration_ms.push_back(duration);
+    g.easing.push_back(e);
+    g.poses.insert(g.poses.end(), pose, pose + g.joints);
+}
+
+constexpr char kBinaryMagic[4] = {'L', 'H', 'A', 'G'};
+constexpr uint16_t kBinaryVersion = 1;
+
+}  // namespace detail
+
+// 文本格式（# 起注释，空白分隔）：
+//   model L10
+//   joints 10
+//   frame <时长ms> <step|linear|smooth> <v1> ... <vN>     "." 表示沿用上一帧该关节
+inline ActionGroup parseActionGroupText(const std::string& text)
+{
+    ActionGroup g;
+    bool has_model = false;
+    std::vector<uint8_t> prev;
+    std::istringstream in(text);
+    std::string line;
+    size_t lineno = 0;
+    auto fail = [&lineno](const std::string& why) -> InvalidParameterException {
+        return InvalidParameterException("action group line " + std::to_string(lineno) + ": " + why);
+    };
+
+    while (std::getline(in, line)) {
+        ++lineno;
+        const auto hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+        std::istringstream ls(line);
+        std::string key;
+        if (!(ls >> key)) continue;
+
+        if (key == "model") {
+            std::string name;
+            if (!(ls >> name) || !parseLinkerHandName(name, g.model)) throw fail("unknown model");
+            has_model = true;
+        } else if (key == "joints") {
+            int n = 0;
+            if (!(ls >> n) || n <= 0 || n > 255 || !g.poses.empty()) throw fail("bad joints");
+            g.joints = static_cast<uint8_t>(n);
+            prev.assign(g.joints, 0);
+        } else if (key == "frame") {
+            if (!has_model || g.joints == 0) throw fail("frame before model/joints");
+            long duration = -1;
+            std::string ease;
+            if (!(ls >> duration >> ease) || duration < 0) throw fail("bad frame header");
+            Easing e;
+            if (ease == "step")        e = Easing::Step;
+            else if (ease == "linear") e = Easing::Linear;
+            else if (ease == "smooth") e = Easing::Smooth;
+            else throw fail("unknown easing '" + ease + "'");
+
+            std::vector<uint8_t> pose(g.joints);
+            for (size_t j = 0; j < g.joints; ++j) {
+                std::string tok;
+                if (!(ls >> tok)) throw fail("expected " + std::to_string(g.joints) + " joint values");
+                if (tok == ".") {
+                    if (g.frames() == 0) throw fail("'.' in first frame");
+                    pose[j] = prev[j];
+                    continue;
+                }
+                char* end = nullptr;
+                const long v = std::strtol(tok.c_str(), &end, 10);
+                if (*end != '\0' || v < 0 || v > 255) throw fail("joint value out of range: " + tok);
+                pose[j] = static_cast<uint8_t>(v);
+            }
+            std::string extra;
+            if (ls >> extra) throw fail("too many joint values");
+            detail::appendFrame(g, static_cast<uint32_t>(duration), e, pose.data());
+            prev = pose;
+        } else {
+            throw fail("unknown directive '" + key + "'");
+        }
+    }
+    if (g.frames() == 0) throw InvalidParameterException("action group: no frames");
+    return g;
+}
+
+// 二进制格式（小端）：
+//   "LHAG" u16 版本  u8 型号  u8 关节数  u32 帧数
+//   每帧：u32 时长ms  u8 缓动  u8[关节数] 姿态
+inline std::vector<uint8_t> serializeActionGroup(const ActionGroup& g)
+{
+    std::vector<uint8_t> out(detail::kBinaryMagic, detail::kBinaryMagic + 4);
+    auto put = [&out](uint32_t v, int bytes) {
+        for (int i = 0; i < bytes; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+    };
+    put(detail::kBinaryVersion, 2);
+    put(static_cast<uint32_t>(g.model), 1);
+    put(g.joints, 1);
+    put(static_cast<uint32_t>(g.frames()), 4);
+    for (size_t f = 0; f < g.frames(); ++f) {
+        put(g.duration_ms[f], 4);
+        put(static_cast<uint32_t>(g.easing[f]), 1);
+        out.insert(out.end(), g.pose(f), g.pose(f) + g.joints);
+    }
+    return out;
+}
+
+inline ActionGroup parseActionGroupBinary(const uint8_t* data, size_t size)
+{
+    auto bad = [] { return InvalidParameterException("action group: malformed binary"); };
+    size_t off = 0;
+    auto get = [&](int bytes) {
+        if (off + bytes > size) throw bad();
+        uint32_t v = 0;
+        for (int i = 0; i < bytes; ++i) v |= static_cast<uint32_t>(data[off + i]) << (8 * i);
+        off += bytes;
+        return v;
+    };
+    if (size < 4 || std::memcmp(data, detail::kBinaryMagic, 4) != 0) throw bad();
+    off = 4;
+    if (get(2) != detail::kBinaryVersion) throw InvalidParameterException("action group: unsupported version");
+    ActionGroup g;
+    const uint32_t model = get(1);
+    if (model > static_cast<uint32_t>(O20)) throw bad();
+    g.model = static_cast<LINKER_HAND>(model);
+    g.joints = static_cast<uint8_t>(get(1));
+    const uint32_t frames = get(4);
+    if (g.joints == 0 || frames == 0 || frames > (size - off) / (5u + g.joints)) throw bad();
+    g.start_ms.reserve(frames);
+    g.duration_ms.reserve(frames);
+    g.easing.reserve(frames);
+    g.poses.reserve(static_cast<size_t>(frames) * g.joints);
+    for (uint32_t f = 0; f < frames; ++f) {
+        const uint32_t duration = get(4);
+        const uint32_t e = get(1);
+        if (e > static_cast<uint32_t>(Easing::Smooth) || off + g.joints > size) throw bad();
+        detail::appendFrame(g, duration, static_cast<Easing>(e), data + off);
+        off += g.joints;
+    }
+    return g;
+}
+
+// 按魔数自动识别文本/二进制
+inline ActionGroup loadActionGroup(const std::string& path)
+{
+    std::ifstream f(path, std::ios::binary);
+    if (!f) throw InvalidParameterException("action group: cannot open " + path);
+    const std::string bytes((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    if (bytes.size() >= 4 && std::memcmp(bytes.data(), detail::kBinaryMagic, 4) == 0) {
+        return parseActionGroupBinary(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+    }
+    return parseActionGroupText(bytes);
+}
+
+// 在 t 毫秒处求姿态，写入 out（大小 = joints）；t 超出末尾取最后一帧
+inline void sampleActionGroup(const ActionGroup& g, double t_ms, uint8_t* out)
+{
+    if (g.frames() == 0) return;
+    const auto it = std::upper_bound(g.start_ms.begin(), g.start_ms.end(), t_ms,
+                                     [](double t, uint32_t s) { return t < s; });
+    const size_t f = it == g.start_ms.begin() ? 0 : static_cast<size_t>(it - g.start_ms.begin()) - 1;
+    const uint8_t* to = g.pose(f);
+    const uint32_t d = g.duration_ms[f];
+    if (g.easing[f] == Easing::Step || f == 0 || d == 0 || t_ms >= g.start_ms[f] + d) {
+        std::memcpy(out, to, g.joints);
+        return;
+    }
+    const uint8_t* from = g.pose(f - 1);
+    double u = std::clamp((t_ms - g.start_ms[f]) / d, 0.0, 1.0);
+    if (g.easing[f] == Easing::Smooth) u = u * u * u * (10.0 - 15.0 * u + 6.0 * u * u);
+    for (size_t j = 0; j < g.joints; ++j) {
+        out[j] = static_cast<uint8_t>(std::lround(from[j] + (to[j] - from[j]) * u));
+    }
+}
+
+struct ActionGroupPlayerStats {
+    uint64_t commands       = 0;  // 已下发的 setPosition 次数
+    uint64_t command_errors = 0;  // 其中抛出异常的次数，最近一次见 lastError()
+};
+
+// 动作组播放器：定时器线程按绝对截止时刻采样并 setPosition，姿态不变的周期不下发。
+// play() 可在播放中调用，新动作组从头替换旧的。
+class ActionGroupPlayer
+{
+public:
+    // api_mutex：与其他线程（如 PollScheduler::apiMutex()）共用的 LinkerHandApi 锁，可为空；
+    // thread：定时器线程的调度配置，在线程启动时套用，失败见 threadError()
+    ActionGroupPlayer(LinkerHandApi& hand, LINKER_HAND model, std::mutex* api_mutex = nullptr,
+                      const ThreadConfig& thread = ThreadConfig())
+        : hand_(hand), model_(model), api_mutex_(api_mutex ? api_mutex : &own_api_mutex_), thread_(thread) {}
+
+    ~ActionGroupPlayer() { stop(); }
+
+    ActionGroupPlayer(const ActionGroupPlayer&) = delete;
+    ActionGroupPlayer& operator=(const ActionGroupPlayer&) = delete;
+
+    void play(std::shared_ptr<const ActionGroup> group, double rate_hz = 30.0, bool loop = false)
+    {
+        if (!group || group->frames() == 0) throw InvalidParameterException("ActionGroupPlayer::play: empty group");
+        if (group->model != model_) {
+            throw InvalidParameterException(std::string("ActionGroupPlayer::play: group is for ")
+                                            + linkerHandName(group->model) + ", hand is " + linkerHandName(model_));
+        }
+        if (!(rate_hz > 0.0)) throw InvalidParameterException("ActionGroupPlayer::play: rate_hz must be positive");
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            group_ = std::move(group);
+            period_ = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rate_hz));
+            loop_ = loop;
+            generation_++;
+            playing_ = true;
+            if (!worker_.joinable()) {
+                stopping_ = false;
+                worker_ = std::thread([this] {
+                    thread_result_.apply(thread_);
+                    run();
+                });
+            }
+        }
+        cv_.notify_all();
+    }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        if (worker_.joinable()) worker_.join();
+        std::lock_guard<std::mutex> lk(mutex_);
+        playing_ = false;
+        done_cv_.notify_all();
+    }
+
+    std::error_code threadError() const { return thread_result_.error(); }
+
+    ActionGroupPlayerStats stats() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return stats_;
+    }
+
+    // 最近一次 setPosition 抛出的异常，从未失败为空
+    std::exception_ptr lastError() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return last_error_;
+    }
+
+    bool isPlaying() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return playing_;
+    }
+
+    // 等播放结束（循环播放永不结束）；超时前结束返回 true
+    template <typename Rep, typename Period>
+    bool waitDone(const std::chrono::duration<Rep, Period>& timeout)
+    {
+        std::unique_lock<std::mutex> lk(mutex_);
+        return done_cv_.wait_for(lk, timeout, [this] { return !playing_; });
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lk(mutex_);
+        uint64_t generation = 0;
+        std::shared_ptr<const ActionGroup> group;
+        Clock::time_point t0, deadline;
+        std::vector<uint8_t> pose, last;
+
+        while (!stopping_) {
+            if (!playing_) {
+                cv_.wait(lk, [this] { return stopping_ || playing_; });
+                continue;
+            }
+            if (generation != generation_) {  // 新动作组：从头开始
+                generation = generation_;
+                group = group_;
+                t0 = deadline = Clock::now();
+                pose.assign(group->joints, 0);
+                last.clear();
+            }
+            const auto period = period_;
+            const bool loop = loop_;
+            lk.unlock();
+
+            double t_ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+            const double total = group->totalMs();
+            bool finished = false;
+            if (t_ms >= total) {
+                if (loop && total > 0) {
+                    t_ms = std::fmod(t_ms, total);
+                } else {
+                    t_ms = total;
+                    finished = true;
+                }
+            }
+            sampleActionGroup(*group, t_ms, pose.data());
+            const bool send = pose != last;
+            std::exception_ptr error;
+            if (send) {
+                try {
+                    std::lock_guard<std::mutex> api(*api_mutex_);
+                    hand_.setPosition(pose);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                last = pose;
+            }
+
+            lk.lock();
+            if (send) ++stats_.commands;
+            if (error) {
+                ++stats_.command_errors;
+                last_error_ = error;
+            }
+            if (finished && generation == generation_) {
+                playing_ = false;
+                done_cv_.notify_all();
+                continue;
+            }
+            deadline += period;
+            const auto now = Clock::now();
+            if (now > deadline + period) deadline = now;  // 落后过多不补发
+            cv_.wait_until(lk, deadline, [this, generation] { return stopping_ || generation != generation_; });
+        }
+    }
+
+    LinkerHandApi& hand_;
+    LINKER_HAND    model_;
+    std::mutex     own_api_mutex_;
+    std::mutex*    api_mutex_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable done_cv_;
+    std::shared_ptr<const ActionGroup> group_;
+    Clock::duration period_{};
+    bool loop_ = false;
+    bool playing_ = false;
+    bool stopping_ = false;
+    uint64_t generation_ = 0;
+    ActionGroupPlayerStats stats_;
+    std::exception_ptr last_error_;
+    ThreadConfig thread_;
+    ThreadConfigResult thread_result_;
+    std::thread worker_;
+};
+
+}  // namespace api
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_ACTION_GROUP_H
@@ -0,0 +1,222 @@
+#ifndef LINKERHAND_ARC_CONVERSION_H
+#define LINKERHAND_ARC_CONVERSION_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+#include "LinkerHandApi.h"
+#include "core/ErrorCode.h"
+
+namespace linkerhand {
+namespace api {
+
+// 批量 范围值(0~255) ↔ 弧度 转换表。
+//
+// setPositionArc / getPositionArc / testPositionArc 每次只转换一帧并返回新的 vector，
+// 不适合对录制数据整批转换。ArcTable 对每个关节预先计算 256 个离散值对应的弧度：
+//   - 范围 → 弧度：逐元素查表；
+//   - 弧度 → 范围：按关节的线性反变换 + 饱和 + 就近取整，x86 上用 SSE2/AVX 向量化。
+// 数据按 frames × joints 行优先连续存放，调用过程中不分配内存。
+class ArcTable
+{
+public:
+    ArcTable() = default;
+
+    // 用 SDK 自身的换算（testPositionArc）逐值建表，结果与单帧接口逐位一致。
+    // 建表期间临时屏蔽 std::cout（testPositionArc 会打印诊断信息）。O20 不支持弧度接口。
+    static ArcTable fromApi(LinkerHandApi& hand, LINKER_HAND model)
+    {
+        const size_t n = jointCount(model);
+        ArcTable t;
+        t.joints_ = n;
+        t.lut_.resize(n * 256);
+        std::ostringstream sink;
+        std::streambuf* old = std::cout.rdbuf(sink.rdbuf());
+        try {
+            for (int v = 0; v < 256; ++v) {
+                const auto arc = hand.testPositionArc(std::vector<uint8_t>(n, static_cast<uint8_t>(v)));
+                if (arc.size() != n) {
+                    throw UnsupportedFeatureException("position arc conversion for this model");
+                }
+                for (size_t j = 0; j < n; ++j) t.lut_[j * 256 + v] = arc[j];
+                sink.str(std::string());
+            }
+        } catch (...) {
+            std::cout.rdbuf(old);
+            throw;
+        }
+        std::cout.rdbuf(old);
+        t.buildInverse();
+        return t;
+    }
+
+    // 按各关节在范围值 0 与 255 处的弧度线性建表（离线使用、无需 SDK 实例）
+    static ArcTable fromEndpoints(const std::vector<double>& arc_at_0, const std::vector<double>& arc_at_255)
+    {
+        if (arc_at_0.empty() || arc_at_0.size() != arc_at_255.size()) {
+            throw InvalidParameterException("arc endpoints: size mismatch");
+        }
+        ArcTable t;
+        t.joints_ = arc_at_0.size();
+        t.lut_.resize(t.joints_ * 256);
+        for (size_t j = 0; j < t.joints_; ++j) {
+            for (int v = 0; v < 256; ++v) {
+                t.lut_[j * 256 + v] = arc_at_0[j] + (arc_at_255[j] - arc_at_0[j]) * v / 255.0;
+            }
+        }
+        t.buildInverse();
+        return t;
+    }
+
+    // 各型号位置向量长度（testPositionArc 的入参长度）
+    static size_t jointCount(LINKER_HAND model)
+    {
+        switch (model) {
+            case L6:  case O6:  return 6;
+            case L7:            return 7;
+            case L10:           return 10;
+            case L20:           return 20;
+            case G20:           return 16;
+            case L21: case L25: return 25;
+            case O20:           break;
+        }
+        throw UnsupportedFeatureException("position arc conversion for O20");
+    }
+
+    size_t joints() const { return joints_; }
+    bool empty() const { return joints_ == 0; }
+
+    double arc(size_t joint, uint8_t value) const { return lut_[joint * 256 + value]; }
+
+    uint8_t range(size_t joint, double arc) const { return toRange(arc * scale_[joint] + offset_[joint]); }
+
+    // in/out 均为 frames × joints
+    void rangeToArc(const uint8_t* in, double* out, size_t frames) const
+    {
+        const double* lut = lut_.data();
+        for (size_t f = 0; f < frames; ++f) {
+            for (size_t j = 0; j < joints_; ++j) out[j] = lut[j * 256 + in[j]];
+            in += joints_;
+            out += joints_;
+        }
+    }
+
+    void arcToRange(const double* in, uint8_t* out, size_t frames) const
+    {
+        const size_t n = frames * joints_;
+        const size_t period = tiled_scale_.size();  // joints × 8，每 8 个元素一组时关节系数按此周期重复
+        const double* sc = tiled_scale_.data();
+        const double* of = tiled_offset_.data();
+        size_t i = 0;
+        size_t k = 0;
+#if defined(__AVX__)
+        const __m256d lo = _mm256_setzero_pd();
+        const __m256d hi = _mm256_set1_pd(255.0);
+        for (; i + 8 <= n; i += 8) {
+            __m256d a = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(in + i), _mm256_loadu_pd(sc + k)),
+                                      _mm256_loadu_pd(of + k));
+            __m256d b = _mm256_add_pd(_mm256_mul_pd(_mm256_loadu_pd(in + i + 4), _mm256_loadu_pd(sc + k + 4)),
+                                      _mm256_loadu_pd(of + k + 4));
+            // max(x, 0) 在 x 为 NaN 时取 0
+            a = _mm256_min_pd(_mm256_max_pd(a, lo), hi);
+            b = _mm256_min_pd(_mm256_max_pd(b, lo), hi);
+            const __m128i w = _mm_packs_epi32(_mm256_cvtpd_epi32(a), _mm256_cvtpd_epi32(b));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(w, w));
+            k += 8;
+            if (k == period) k = 0;
+        }
+#elif defined(__SSE2__) || defined(_M_X64)
+        const __m128d lo = _mm_setzero_pd();
+        const __m128d hi = _mm_set1_pd(255.0);
+        for (; i + 8 <= n; i += 8) {
+            __m128i q[4];
+            for (int h = 0; h < 4; ++h) {
+                __m128d x = _mm_add_pd(_mm_mul_pd(_mm_loadu_pd(in + i + 2 * h), _mm_loadu_pd(sc + k + 2 * h)),
+                                       _mm_loadu_pd(of + k + 2 * h));
+                q[h] = _mm_cvtpd_epi32(_mm_min_pd(_mm_max_pd(x, lo), hi));
+            }
+            const __m128i w = _mm_packs_epi32(_mm_unpacklo_epi64(q[0], q[1]), _mm_unpacklo_epi64(q[2], q[3]));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(w, w));
+            k += 8;
+            if (k == period) k = 0;
+        }
+#endif
+        for (; i < n; ++i) {
+            out[i] = toRange(in[i] * sc[k] + of[k]);
+            if (++k == period) k = 0;
+        }
+    }
+
+    // 便捷重载：元素数须为 joints 的整数倍
+    std::vector<double> rangeToArc(const std::vector<uint8_t>& poses) const
+    {
+        std::vector<double> out(poses.size());
+        rangeToArc(poses.data(), out.data(), checkedFrames(poses.size()));
+        return out;
+    }
+
+    std::vector<uint8_t> arcToRange(const std::vector<double>& poses) const
+    {
+        std::vector<uint8_t> out(poses.size());
+        arcToRange(poses.data(), out.data(), checkedFrames(poses.size()));
+        return out;
+    }
+
+private:
+    // 由查表端点求线性反变换；两端相同的关节（型号上不存在的关节）恒映射为 0
+    void buildInverse()
+    {
+        scale_.assign(joints_, 0.0);
+        offset_.assign(joints_, 0.0);
+        for (size_t j = 0; j < joints_; ++j) {
+            const double a0 = lut_[j * 256];
+            const double a1 = lut_[j * 256 + 255];
+            if (a1 != a0) {
+                scale_[j]  = 255.0 / (a1 - a0);
+                offset_[j] = -a0 * scale_[j];
+            }
+        }
+        tiled_scale_.resize(joints_ * 8);
+        tiled_offset_.resize(joints_ * 8);
+        for (size_t i = 0; i < tiled_scale_.size(); ++i) {
+            tiled_scale_[i]  = scale_[i % joints_];
+            tiled_offset_[i] = offset_[i % joints_];
+        }
+    }
+
+    // 饱和到 [0, 255] 后就近取整（与向量路径的 cvtpd 舍入一致）；NaN 记为 0
+    static uint8_t toRange(double v)
+    {
+        v = v > 0.0 ? v : 0.0;
+        v = v < 255.0 ? v : 255.0;
+        return static_cast<uint8_t>(std::nearbyint(v));
+    }
+
+    size_t checkedFrames(size_t elements) const
+    {
+        if (joints_ == 0 || elements % joints_ != 0) {
+            throw InvalidParameterException("poses: size is not a multiple of joint count");
+        }
+        return elements / joints_;
+    }
+
+    size_t joints_ = 0;
+    std::vector<double> lut_;           // joints × 256
+    std::vector<double> scale_;
+    std::vector<double> offset_;
+    std::vector<double> tiled_scale_;   // scale_ 重复 8 次，供向量路径按周期取系数
+    std::vector<double> tiled_offset_;
+};
+
+}  // namespace api
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_ARC_CONVERSION_H
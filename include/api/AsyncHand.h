@@ -0,0 +1,352 @@
+#ifndef LINKERHAND_ASYNC_HAND_H
+#define LINKERHAND_ASYNC_HAND_H
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "LinkerHandApi.h"
+#include "RequestPlan.h"
+#include "communication/RequestCorrelator.h"
+#include "core/ThreadConfig.h"
+
+namespace linkerhand {
+namespace api {
+
+// 异步请求层。
+//
+// SDK 的 getter 语义是"发出请求帧 + 返回上一次应答的缓存"，同步写法要拿到新鲜值只能
+// 逐个 getter 调用、逐个等一个往返。AsyncHand 把排队的读请求攒成一批：
+//   1. fire：依次调用各 getter，把全部请求帧背靠背发上总线；
+//   2. 等待 settle 窗口，让所有应答在同一个往返内到达；
+//   3. collect：再次调用 getter 取回缓存并兑现 future / 回调。
+// N 个通道的刷新因此只花约一个往返。同一批里重复的读请求合并为一次。
+// 写指令按提交顺序在每批 fire 之前执行。
+// 接入 RequestCorrelator（setPipeline）后，已知命令表的通道绕过 SDK 的节流发送队列，
+// 由关联器直接把请求帧背靠背发出并逐个匹配应答；settle 只作为上限，应答收齐即 collect。
+// 这类通道 collect 时 getter 再发的请求帧由关联器吞掉，只读缓存；settle 内应答未收齐的请求
+// 以 HandError::Timeout 失败，不返回旧缓存。
+class AsyncHand
+{
+public:
+    using Bytes  = std::vector<uint8_t>;
+    using Matrix = std::vector<std::vector<uint8_t>>;
+    using Cube   = std::vector<std::vector<std::vector<uint8_t>>>;
+
+    // settle：请求发出到应答全部到达的等待窗口；经典 CAN 1Mbps 下几个毫秒足够。
+    // api_mutex：与其他线程（如 PollScheduler::apiMutex()）共用的 LinkerHandApi 锁，可为空。
+    // thread：批处理线程的调度配置，在线程启动时套用，失败见 threadError()。
+    explicit AsyncHand(LinkerHandApi& hand,
+                       std::chrono::microseconds settle = std::chrono::microseconds(5000),
+                       std::mutex* api_mutex = nullptr, const ThreadConfig& thread = ThreadConfig())
+        : hand_(hand), settle_(settle), api_mutex_(api_mutex ? api_mutex : &own_api_mutex_)
+    {
+        worker_ = std::thread([this, thread] {
+            thread_result_.apply(thread);
+            run();
+        });
+    }
+
+    ~AsyncHand()
+    {
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        if (worker_.joinable()) worker_.join();
+    }
+
+    AsyncHand(const AsyncHand&) = delete;
+    AsyncHand& operator=(const AsyncHand&) = delete;
+
+    std::error_code threadError() const { return thread_result_.error(); }
+
+    // ---------------- 读：future 版本 ----------------
+    std::future<Bytes>  requestPosition()    { return read<Bytes>(kPosition, &LinkerHandApi::getPosition); }
+    std::future<Bytes>  requestSpeed()       { return read<Bytes>(kSpeed, &LinkerHandApi::getSpeed); }
+    std::future<Bytes>  requestTorque()      { return read<Bytes>(kTorque, &LinkerHandApi::getTorque); }
+    std::future<Bytes>  requestTemperature() { return read<Bytes>(kTemperature, &LinkerHandApi::getTemperature); }
+    std::future<Bytes>  requestFaultCode()   { return read<Bytes>(kFaultCode, &LinkerHandApi::getFaultCode); }
+    std::future<Cube>   requestForce()       { return read<Cube>(kForce, &LinkerHandApi::getForce); }
+    std::future<Matrix> requestPalmForce()   { return read<Matrix>(kPalmForce, &LinkerHandApi::getPalmForce); }
+    std::future<std::string> requestVersion() { return read<std::string>(kVersion, &LinkerHandApi::getVersion); }
+
+    // ---------------- 读：回调版本（在工作线程执行，异常以 exception_ptr 传入） ----------------
+    template <typename T>
+    using Completion = std::function<void(const T&, std::exception_ptr)>;
+
+    void requestPosition(Completion<Bytes> cb) { read<Bytes>(kPosition, &LinkerHandApi::getPosition, std::move(cb)); }
+    void requestSpeed(Completion<Bytes> cb)    { read<Bytes>(kSpeed, &LinkerHandApi::getSpeed, std::move(cb)); }
+    void requestTorque(Completion<Bytes> cb)   { read<Bytes>(kTorque, &LinkerHandApi::getTorque, std::move(cb)); }
+    void requestTemperature(Completion<Bytes> cb) { read<Bytes>(kTemperature, &LinkerHandApi::getTemperature, std::move(cb)); }
+    void requestFaultCode(Completion<Bytes> cb) { read<Bytes>(kFaultCode, &LinkerHandApi::getFaultCode, std::move(cb)); }
+    void requestForce(Completion<Cube> cb)     { read<Cube>(kForce, &LinkerHandApi::getForce, std::move(cb)); }
+    void requestPalmForce(Completion<Matrix> cb) { read<Matrix>(kPalmForce, &LinkerHandApi::getPalmForce, std::move(cb)); }
+
+    // ---------------- 写：按提交顺序执行 ----------------
+    std::future<void> setPosition(Bytes pose)
+    {
+        return write([pose = std::move(pose)](LinkerHandApi& h) { h.setPosition(pose); });
+    }
+    std::future<void> setSpeed(Bytes speed)
+    {
+        return write([speed = std::move(speed)](LinkerHandApi& h) { h.setSpeed(speed); });
+    }
+    std::future<void> setTorque(Bytes torque)
+    {
+        return write([torque = std::move(torque)](LinkerHandApi& h) { h.setTorque(torque); });
+    }
+
+    void setSettle(std::chrono::microseconds settle)
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        settle_ = settle;
+    }
+
+    // correlator 须已通过 wrapTx / wrapRx 接入同一只手的回调，并改按该型号命令表登记应答帧数
+    // （setReplyCounter）；传 nullptr 恢复固定 settle
+    void setPipeline(communication::RequestCorrelator* correlator, LINKER_HAND model, HAND_TYPE type)
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        correlator_ = correlator;
+        if (correlator) correlator->setReplyCounter(requestReplyCounter(model));
+        for (size_t i = 0; i < kPollChannelCount; ++i) {
+            plan_[i] = readRequestFrames(model, static_cast<PollChannel>(i));
+        }
+        can_id_ = static_cast<uint32_t>(type);
+    }
+
+private:
+    // 前 7 项与 PollChannel 顺序一致，用于查命令表
+    enum Key : int {
+        kPosition, kSpeed, kTorque, kTemperature, kFaultCode, kForce, kPalmForce, kVersion
+    };
+
+    // 同一 key 的读请求在一批内只 fire / collect 一次，结果广播给所有等待者
+    struct ReadJob {
+        int key = 0;
+        std::function<void(LinkerHandApi&)> fire;
+        std::function<std::function<void()>(LinkerHandApi&)> collect;  // 取值，返回兑现动作
+        std::function<void(std::exception_ptr)> fail;
+        std::function<void(const std::shared_ptr<void>&)> merge;  // 把同 key 的新等待者并入
+        std::shared_ptr<void> waiters;
+    };
+
+    template <typename T>
+    struct Waiters {
+        std::vector<std::promise<T>> promises;
+        std::vector<Completion<T>>   callbacks;
+
+        // 用户回调抛出的异常不外传，避免打断同批其他等待者
+        void resolve(const T& v)
+        {
+            for (auto& p : promises) p.set_value(v);
+            for (auto& cb : callbacks) {
+                try { cb(v, nullptr); } catch (...) {}
+            }
+        }
+        void reject(std::exception_ptr e)
+        {
+            for (auto& p : promises) p.set_exception(e);
+            for (auto& cb : callbacks) {
+                try { cb(T{}, e); } catch (...) {}
+            }
+        }
+    };
+
+    template <typename T>
+    std::future<T> read(int key, T (LinkerHandApi::*getter)())
+    {
+        auto w = std::make_shared<Waiters<T>>();
+        w->promises.emplace_back();
+        auto fut = w->promises.back().get_future();
+        enqueueRead<T>(key, getter, std::move(w));
+        return fut;
+    }
+
+    template <typename T>
+    void read(int key, T (LinkerHandApi::*getter)(), Completion<T> cb)
+    {
+        auto w = std::make_shared<Waiters<T>>();
+        w->callbacks.push_back(std::move(cb));
+        enqueueRead<T>(key, getter, std::move(w));
+    }
+
+    template <typename T>
+    void enqueueRead(int key, T (LinkerHandApi::*getter)(), std::shared_ptr<Waiters<T>> w)
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        for (auto& job : reads_) {
+            if (job.key == key) {
+                job.merge(w);
+                return;
+            }
+        }
+        ReadJob job;
+        job.key = key;
+        job.waiters = w;
+        job.fire = [getter](LinkerHandApi& h) { (void)(h.*getter)(); };
+        job.collect = [getter, w](LinkerHandApi& h) -> std::function<void()> {
+            auto v = std::make_shared<T>((h.*getter)());
+            return [w, v] { w->resolve(*v); };
+        };
+        job.fail = [w](std::exception_ptr e) { w->reject(e); };
+        job.merge = [w](const std::shared_ptr<void>& other) {
+            auto o = std::static_pointer_cast<Waiters<T>>(other);
+            for (auto& p : o->promises) w->promises.push_back(std::move(p));
+            for (auto& cb : o->callbacks) w->callbacks.push_back(std::move(cb));
+        };
+        reads_.push_back(std::move(job));
+        cv_.notify_all();
+    }
+
+    // 按命令表直接发出请求；该通道无命令表或发送失败时返回 false，改走 getter
+    bool pipelined(int key, const std::array<std::vector<RequestFrame>, kPollChannelCount>& plan,
+                   uint32_t can_id, communication::RequestCorrelator& correlator,
+                   std::vector<communication::RequestCorrelator::Ticket>& tickets)
+    {
+        if (key >= kVersion || plan[key].empty()) return false;
+        for (const auto& f : plan[key]) {
+            const auto t = correlator.request(can_id, f.data, f.len, f.replies);
+            if (t == 0) {
+                tickets.clear();
+                return false;
+            }
+            tickets.push_back(t);
+        }
+        return true;
+    }
+
+    template <typename Fn>
+    std::future<void> write(Fn&& fn)
+    {
+        auto p = std::make_shared<std::promise<void>>();
+        auto fut = p->get_future();
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            writes_.push_back([p, fn = std::forward<Fn>(fn)](LinkerHandApi& h) {
+                try {
+                    fn(h);
+                    p->set_value();
+                } catch (...) {
+                    p->set_exception(std::current_exception());
+                }
+            });
+        }
+        cv_.notify_all();
+        return fut;
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lk(mutex_);
+        while (true) {
+            cv_.wait(lk, [this] { return stopping_ || !reads_.empty() || !writes_.empty(); });
+            if (stopping_) break;
+
+            std::deque<std::function<void(LinkerHandApi&)>> writes;
+            std::vector<ReadJob> reads;
+            writes.swap(writes_);
+            reads.swap(reads_);
+            const auto settle = settle_;
+            auto* correlator = correlator_;
+            const auto plan = correlator ? plan_ : decltype(plan_){};
+            const uint32_t can_id = can_id_;
+            lk.unlock();
+
+            {
+                std::lock_guard<std::mutex> api(*api_mutex_);
+                for (auto& w : writes) w(hand_);
+            }
+
+            if (!reads.empty()) {
+                std::vector<std::exception_ptr> errors(reads.size());
+                std::vector<std::function<void()>> resolvers(reads.size());
+                std::vector<std::vector<communication::RequestCorrelator::Ticket>> tickets(reads.size());
+                bool fired_by_sdk = false;
+                {
+                    std::lock_guard<std::mutex> api(*api_mutex_);
+                    for (size_t i = 0; i < reads.size(); ++i) {
+                        if (correlator && pipelined(reads[i].key, plan, can_id, *correlator, tickets[i])) continue;
+                        fired_by_sdk = true;
+                        try { reads[i].fire(hand_); } catch (...) { errors[i] = std::current_exception(); }
+                    }
+                }
+                if (!correlator) {
+                    std::this_thread::sleep_for(settle);
+                } else {
+                    const auto deadline = std::chrono::steady_clock::now() + settle;
+                    for (size_t i = 0; i < reads.size(); ++i) {
+                        bool answered = true;
+                        for (auto t : tickets[i]) {
+                            answered = correlator->wait(t, deadline - std::chrono::steady_clock::now()) && answered;
+                        }
+                        if (!answered) {
+                            errors[i] = std::make_exception_ptr(
+                                HandException(HandError::Timeout, "AsyncHand: no reply within settle"));
+                        }
+                    }
+                    // getter 只把请求帧入队，由 SDK 发送线程约 1ms 一帧地发出，按"在途清空且静默"判定完成
+                    if (fired_by_sdk) {
+                        correlator->waitQuiet(std::chrono::microseconds(1500),
+                                              deadline - std::chrono::steady_clock::now());
+                    }
+                }
+                {
+                    std::lock_guard<std::mutex> api(*api_mutex_);
+                    for (size_t i = 0; i < reads.size(); ++i) {
+                        if (errors[i]) continue;
+                        // 应答已由关联器取得：getter 只为读缓存，它再发的请求帧不上总线
+                        if (!tickets[i].empty()) {
+                            for (const auto& f : plan[reads[i].key]) correlator->suppressNext(can_id, f.data, f.len);
+                        }
+                        try { resolvers[i] = reads[i].collect(hand_); } catch (...) { errors[i] = std::current_exception(); }
+                    }
+                }
+                // 兑现放在 API 锁外，回调里可以继续提交请求或访问其他组件
+                for (size_t i = 0; i < reads.size(); ++i) {
+                    if (errors[i]) reads[i].fail(errors[i]);
+                    else resolvers[i]();
+                }
+            }
+            lk.lock();
+        }
+
+        // 停机：未执行的请求以 InvalidState 拒绝，避免 future 永远挂起
+        auto err = std::make_exception_ptr(HandException(HandError::InvalidState, "AsyncHand stopped"));
+        for (auto& job : reads_) job.fail(err);
+        reads_.clear();
+        writes_.clear();  // promise 析构时 future 得到 broken_promise
+    }
+
+    LinkerHandApi& hand_;
+    std::chrono::microseconds settle_;
+    std::mutex  own_api_mutex_;
+    std::mutex* api_mutex_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+    std::vector<ReadJob> reads_;
+    std::deque<std::function<void(LinkerHandApi&)>> writes_;
+    communication::RequestCorrelator* correlator_ = nullptr;
+    std::array<std::vector<RequestFrame>, kPollChannelCount> plan_;
+    uint32_t can_id_ = 0;
+    ThreadConfigResult thread_result_;
+    std::thread worker_;
+};
+
+}  // namespace api
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_ASYNC_HAND_H
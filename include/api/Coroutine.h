@@ -0,0 +1,723 @@
+#ifndef LINKERHAND_COROUTINE_H
+#define LINKERHAND_COROUTINE_H
+
+// C++20 协程层（可选）：单线程 epoll 执行器 + 对 LinkerHandApi / 传输层的可等待封装。
+// 仅在 Linux 且编译器启用 C++20 协程时可用；否则本头为空，LINKERHAND_HAS_COROUTINES 为 0。
+// 示例构建开关见 examples/CMakeLists.txt 的 BUILD_COROUTINE_EXAMPLES。
+
+#if defined(__linux__) && defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define LINKERHAND_HAS_COROUTINES 1
+#else
+#define LINKERHAND_HAS_COROUTINES 0
+#endif
+
+#if LINKERHAND_HAS_COROUTINES
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "LinkerHandApi.h"
+#include "communication/ICanBus.h"
+#include "communication/ICanFD.h"
+#include "communication/IModbus.h"
+#include "core/ThreadConfig.h"
+
+namespace linkerhand {
+namespace coro {
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+    template <typename P>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept
+    {
+        auto next = h.promise().continuation;
+        return next ? next : std::noop_coroutine();
+    }
+    void await_resume() const noexcept {}
+};
+
+struct PromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+// 自销毁的根协程，用于 EpollExecutor::spawn
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept {}
+    };
+};
+
+}  // namespace detail
+
+// 惰性协程任务：co_await 时才开始执行，结束后对称转移回等待者。
+template <typename T>
+class Task
+{
+public:
+    struct promise_type : detail::PromiseBase {
+        std::optional<T> value;
+
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        template <typename U>
+        void return_value(U&& v) { value.emplace(std::forward<U>(v)); }
+    };
+
+    Task(Task&& o) noexcept : h_(std::exchange(o.h_, {})) {}
+    Task& operator=(Task&& o) noexcept
+    {
+        if (this != &o) {
+            if (h_) h_.destroy();
+            h_ = std::exchange(o.h_, {});
+        }
+        return *this;
+    }
+    ~Task() { if (h_) h_.destroy(); }
+
+    bool await_ready() const noexcept { return !h_ || h_.done(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept
+    {
+        h_.promise().continuation = caller;
+        return h_;
+    }
+    T await_resume()
+    {
+        auto& p = h_.promise();
+        if (p.error) std::rethrow_exception(p.error);
+        return std::move(*p.value);
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> h) : h_(h) {}
+    std::coroutine_handle<promise_type> h_;
+};
+
+template <>
+class Task<void>
+{
+public:
+    struct promise_type : detail::PromiseBase {
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        void return_void() const noexcept {}
+    };
+
+    Task(Task&& o) noexcept : h_(std::exchange(o.h_, {})) {}
+    Task& operator=(Task&& o) noexcept
+    {
+        if (this != &o) {
+            if (h_) h_.destroy();
+            h_ = std::exchange(o.h_, {});
+        }
+        return *this;
+    }
+    ~Task() { if (h_) h_.destroy(); }
+
+    bool await_ready() const noexcept { return !h_ || h_.done(); }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept
+    {
+        h_.promise().continuation = caller;
+        return h_;
+    }
+    void await_resume()
+    {
+        if (h_.promise().error) std::rethrow_exception(h_.promise().error);
+    }
+
+private:
+    explicit Task(std::coroutine_handle<promise_type> h) : h_(h) {}
+    std::coroutine_handle<promise_type> h_;
+};
+
+// 单线程 epoll 执行器。所有协程在 run() 所在线程上恢复；
+// 阻塞型驱动（Modbus 串口、厂商 CAN-FD 库）经 offload() 交给阻塞线程池执行。
+// 每个 fd 只向 epoll 注册一次，读、写方向各可有一个等待者（例如一个协程收、另一个协程发）。
+class EpollExecutor
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // blocking_thread：阻塞线程的调度配置（名字后加序号），失败见 threadError()
+    explicit EpollExecutor(size_t blocking_threads = 1, const ThreadConfig& blocking_thread = ThreadConfig())
+        : blocking_thread_(blocking_thread)
+    {
+        ep_ = ::epoll_create1(EPOLL_CLOEXEC);
+        wake_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (ep_ < 0 || wake_fd_ < 0) {
+            throw CommunicationException("EpollExecutor: epoll/eventfd create failed");
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.ptr = nullptr;  // nullptr 即唤醒事件
+        ::epoll_ctl(ep_, EPOLL_CTL_ADD, wake_fd_, &ev);
+        addBlockingThreads(blocking_threads);
+    }
+
+    ~EpollExecutor()
+    {
+        {
+            std::lock_guard<std::mutex> lk(pool_mutex_);
+            pool_stop_ = true;
+        }
+        pool_cv_.notify_all();
+        for (auto& t : pool_) t.join();
+        ::close(wake_fd_);
+        ::close(ep_);
+    }
+
+    // 追加阻塞线程。CoCanBus / CoCanFD / CoModbus 构造时各追加一个：它们的 recv / transact 会长时间
+    // 占住一个阻塞线程，共用一个线程时一个端点的等待会饿死其他端点。应在 run() 之前调用。
+    void addBlockingThreads(size_t n)
+    {
+        std::lock_guard<std::mutex> lk(pool_mutex_);
+        for (size_t i = 0; i < n; ++i) {
+            const ThreadConfig tc = blocking_thread_.named(std::to_string(pool_.size()));
+            pool_.emplace_back([this, tc] {
+                thread_result_.apply(tc);
+                blockingWorker();
+            });
+        }
+        pool_size_.store(pool_.size(), std::memory_order_release);
+    }
+
+    size_t blockingThreads() const { return pool_size_.load(std::memory_order_acquire); }
+
+    std::error_code threadError() const { return thread_result_.error(); }
+
+    // fd 关闭前调用，撤销其 epoll 注册（不得有协程仍在等待它）
+    void forget(int fd)
+    {
+        auto it = fds_.find(fd);
+        if (it == fds_.end()) return;
+        ::epoll_ctl(ep_, EPOLL_CTL_DEL, fd, nullptr);
+        fds_.erase(it);
+    }
+
+    EpollExecutor(const EpollExecutor&) = delete;
+    EpollExecutor& operator=(const EpollExecutor&) = delete;
+
+    // 启动一个顶层协程；异常被吞掉，需要结果时请在协程内部自行处理
+    void spawn(Task<void> task) { start(std::move(task)); }
+
+    // 线程安全：把协程句柄投递回执行器线程
+    void post(std::coroutine_handle<> h)
+    {
+        {
+            std::lock_guard<std::mutex> lk(post_mutex_);
+            posted_.push_back(h);
+        }
+        wake();
+    }
+
+    // 线程安全
+    void stop()
+    {
+        stop_ = true;
+        wake();
+    }
+
+    // 事件循环，直到 stop()
+    void run()
+    {
+        stop_ = false;
+        epoll_event events[64];
+        while (!stop_) {
+            drainPosted();
+            while (!ready_.empty()) {
+                auto h = ready_.front();
+                ready_.pop_front();
+                h.resume();
+            }
+            if (stop_) break;
+
+            int timeout_ms = -1;
+            if (!timers_.empty()) {
+                const auto left = timers_.top().deadline - Clock::now();
+                const auto ms = std::chrono::ceil<std::chrono::milliseconds>(left).count();
+                timeout_ms = ms < 0 ? 0 : static_cast<int>(ms);
+            }
+            {
+                std::lock_guard<std::mutex> lk(post_mutex_);
+                if (!posted_.empty()) timeout_ms = 0;
+            }
+
+            const int n = ::epoll_wait(ep_, events, 64, timeout_ms);
+            for (int i = 0; i < n; ++i) {
+                if (events[i].data.ptr == nullptr) {
+                    uint64_t v = 0;
+                    ssize_t r = ::read(wake_fd_, &v, sizeof(v));
+                    (void)r;
+                    continue;
+                }
+                dispatch(*static_cast<FdState*>(events[i].data.ptr), events[i].events);
+            }
+            const auto now = Clock::now();
+            while (!timers_.empty() && timers_.top().deadline <= now) {
+                ready_.push_back(timers_.top().handle);
+                timers_.pop();
+            }
+        }
+    }
+
+    // ---------------- 可等待原语 ----------------
+
+    struct IoWait {
+        int fd = -1;
+        uint32_t events = 0;
+        uint32_t revents = 0;
+        std::coroutine_handle<> handle;
+    };
+
+    class IoAwaiter
+    {
+    public:
+        IoAwaiter(EpollExecutor& ex, int fd, uint32_t events) : ex_(ex) { wait_.fd = fd; wait_.events = events; }
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> h)
+        {
+            wait_.handle = h;
+            error_ = ex_.arm(wait_);
+            return error_ == 0;  // 注册失败立即恢复，由 await_resume 抛出
+        }
+        uint32_t await_resume() const
+        {
+            if (error_) throw CommunicationException(std::string("epoll_ctl: ") + std::strerror(error_));
+            return wait_.revents;
+        }
+
+    private:
+        EpollExecutor& ex_;
+        IoWait wait_;
+        int error_ = 0;
+    };
+
+    IoAwaiter readable(int fd) { return IoAwaiter(*this, fd, EPOLLIN); }
+    IoAwaiter writable(int fd) { return IoAwaiter(*this, fd, EPOLLOUT); }
+
+    class TimerAwaiter
+    {
+    public:
+        TimerAwaiter(EpollExecutor& ex, Clock::time_point deadline) : ex_(ex), deadline_(deadline) {}
+        bool await_ready() const noexcept { return deadline_ <= Clock::now(); }
+        void await_suspend(std::coroutine_handle<> h) { ex_.timers_.push({deadline_, ex_.timer_seq_++, h}); }
+        void await_resume() const noexcept {}
+
+    private:
+        EpollExecutor& ex_;
+        Clock::time_point deadline_;
+    };
+
+    TimerAwaiter sleep_until(Clock::time_point deadline) { return TimerAwaiter(*this, deadline); }
+    template <typename Rep, typename Period>
+    TimerAwaiter sleep_for(const std::chrono::duration<Rep, Period>& d)
+    {
+        return TimerAwaiter(*this, Clock::now() + std::chrono::duration_cast<Clock::duration>(d));
+    }
+
+    // 在共享阻塞线程上执行 fn，完成后回到执行器线程继续
+    template <typename Fn>
+    class OffloadAwaiter
+    {
+    public:
+        using R = std::invoke_result_t<Fn&>;
+
+        OffloadAwaiter(EpollExecutor& ex, Fn fn) : ex_(ex), fn_(std::move(fn)) {}
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h)
+        {
+            ex_.submitBlocking([this, h] {
+                try {
+                    if constexpr (std::is_void_v<R>) {
+                        fn_();
+                    } else {
+                        result_.emplace(fn_());
+                    }
+                } catch (...) {
+                    error_ = std::current_exception();
+                }
+                ex_.post(h);
+            });
+        }
+        R await_resume()
+        {
+            if (error_) std::rethrow_exception(error_);
+            if constexpr (!std::is_void_v<R>) return std::move(*result_);
+        }
+
+    private:
+        using Slot = std::conditional_t<std::is_void_v<R>, char, std::optional<R>>;
+        EpollExecutor& ex_;
+        Fn fn_;
+        Slot result_{};
+        std::exception_ptr error_;
+    };
+
+    template <typename Fn>
+    OffloadAwaiter<Fn> offload(Fn fn) { return OffloadAwaiter<Fn>(*this, std::move(fn)); }
+
+private:
+    // 每个 fd 的注册状态：读 / 写方向各一个等待者，epoll 上的关注集合为两者之并（EPOLLONESHOT）
+    struct FdState {
+        int fd = -1;
+        bool added = false;
+        IoWait* reader = nullptr;
+        IoWait* writer = nullptr;
+    };
+
+    static constexpr uint32_t kErrorEvents = EPOLLERR | EPOLLHUP;
+
+    // 按当前等待者重新布防；首次 ADD，之后 MOD。fd 关闭后号码被复用时 MOD 返回 ENOENT，改为 ADD
+    int rearm(FdState& st)
+    {
+        epoll_event ev{};
+        ev.events = EPOLLONESHOT | (st.reader ? st.reader->events : 0u) | (st.writer ? st.writer->events : 0u);
+        ev.data.ptr = &st;
+        int rc = ::epoll_ctl(ep_, st.added ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, st.fd, &ev);
+        if (rc < 0 && st.added && errno == ENOENT) rc = ::epoll_ctl(ep_, EPOLL_CTL_ADD, st.fd, &ev);
+        if (rc < 0 && !st.added && errno == EEXIST) rc = ::epoll_ctl(ep_, EPOLL_CTL_MOD, st.fd, &ev);
+        if (rc < 0) return errno;
+        st.added = true;
+        return 0;
+    }
+
+    int arm(IoWait& w)
+    {
+        std::unique_ptr<FdState>& slot = fds_[w.fd];
+        if (!slot) {
+            slot.reset(new FdState);
+            slot->fd = w.fd;
+        }
+        FdState& st = *slot;
+        IoWait*& dir = (w.events & EPOLLOUT) ? st.writer : st.reader;
+        if (dir != nullptr) return EBUSY;  // 同一方向已有协程在等待
+        dir = &w;
+        const int err = rearm(st);
+        if (err != 0) dir = nullptr;
+        return err;
+    }
+
+    void dispatch(FdState& st, uint32_t events)
+    {
+        if (st.reader && (events & (st.reader->events | kErrorEvents))) {
+            st.reader->revents = events;
+            ready_.push_back(st.reader->handle);
+            st.reader = nullptr;
+        }
+        if (st.writer && (events & (st.writer->events | kErrorEvents))) {
+            st.writer->revents = events;
+            ready_.push_back(st.writer->handle);
+            st.writer = nullptr;
+        }
+        if (st.reader || st.writer) rearm(st);  // EPOLLONESHOT 已解除，另一方向仍在等待
+    }
+
+    struct Timer {
+        Clock::time_point deadline;
+        uint64_t seq;
+        std::coroutine_handle<> handle;
+        bool operator>(const Timer& o) const
+        {
+            return deadline != o.deadline ? deadline > o.deadline : seq > o.seq;
+        }
+    };
+
+    static detail::Detached start(Task<void> task)
+    {
+        try { co_await task; } catch (...) {}
+    }
+
+    void wake()
+    {
+        const uint64_t one = 1;
+        ssize_t r = ::write(wake_fd_, &one, sizeof(one));
+        (void)r;
+    }
+
+    void drainPosted()
+    {
+        std::lock_guard<std::mutex> lk(post_mutex_);
+        while (!posted_.empty()) {
+            ready_.push_back(posted_.front());
+            posted_.pop_front();
+        }
+    }
+
+    void submitBlocking(std::function<void()> job)
+    {
+        if (blockingThreads() == 0) {
+            job();  // 未配置阻塞线程：就地执行（会阻塞执行器）
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lk(pool_mutex_);
+            jobs_.push_back(std::move(job));
+        }
+        pool_cv_.notify_one();
+    }
+
+    void blockingWorker()
+    {
+        std::unique_lock<std::mutex> lk(pool_mutex_);
+        while (true) {
+            pool_cv_.wait(lk, [this] { return pool_stop_ || !jobs_.empty(); });
+            if (pool_stop_ && jobs_.empty()) return;
+            auto job = std::move(jobs_.front());
+            jobs_.pop_front();
+            lk.unlock();
+            job();
+            lk.lock();
+        }
+    }
+
+    int ep_ = -1;
+    int wake_fd_ = -1;
+    std::atomic<bool> stop_{false};
+
+    std::deque<std::coroutine_handle<>> ready_;
+    std::mutex post_mutex_;
+    std::deque<std::coroutine_handle<>> posted_;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;
+    uint64_t timer_seq_ = 0;
+    std::unordered_map<int, std::unique_ptr<FdState>> fds_;  // 仅执行器线程访问
+
+    ThreadConfig blocking_thread_;
+    ThreadConfigResult thread_result_;
+    std::vector<std::thread> pool_;
+    std::atomic<size_t> pool_size_{0};
+    std::mutex pool_mutex_;
+    std::condition_variable pool_cv_;
+    std::deque<std::function<void()>> jobs_;
+    bool pool_stop_ = false;
+};
+
+// LinkerHandApi 的协程封装。getter 本身只入队请求帧并返回缓存，不阻塞；
+// co_await position() = 发请求 → 在执行器上挂起 settle → 取回缓存，整个过程不占额外线程。
+// 同一只手的全部调用须在同一执行器线程上进行。
+class CoHand
+{
+public:
+    using Bytes = std::vector<uint8_t>;
+
+    CoHand(EpollExecutor& ex, LinkerHandApi& hand,
+           std::chrono::microseconds settle = std::chrono::microseconds(5000))
+        : ex_(ex), hand_(hand), settle_(settle) {}
+
+    Task<Bytes> position()    { return read(&LinkerHandApi::getPosition); }
+    Task<Bytes> speed()       { return read(&LinkerHandApi::getSpeed); }
+    Task<Bytes> torque()      { return read(&LinkerHandApi::getTorque); }
+    Task<Bytes> temperature() { return read(&LinkerHandApi::getTemperature); }
+    Task<Bytes> faultCode()   { return read(&LinkerHandApi::getFaultCode); }
+    Task<std::vector<std::vector<std::vector<uint8_t>>>> force() { return read(&LinkerHandApi::getForce); }
+    Task<std::vector<std::vector<uint8_t>>> palmForce() { return read(&LinkerHandApi::getPalmForce); }
+    Task<std::string> version() { return read(&LinkerHandApi::getVersion); }
+
+    // 指令只入队发送帧，直接调用即可；提供同名方法便于统一写法
+    void setPosition(const Bytes& pose) { hand_.setPosition(pose); }
+    void setSpeed(const Bytes& speed)   { hand_.setSpeed(speed); }
+    void setTorque(const Bytes& torque) { hand_.setTorque(torque); }
+
+    LinkerHandApi& api() { return hand_; }
+
+private:
+    template <typename T>
+    Task<T> read(T (LinkerHandApi::*getter)())
+    {
+        (void)(hand_.*getter)();
+        co_await ex_.sleep_for(settle_);
+        co_return (hand_.*getter)();
+    }
+
+    EpollExecutor& ex_;
+    LinkerHandApi& hand_;
+    std::chrono::microseconds settle_;
+};
+
+// 原生 SocketCAN 协程端点：非阻塞套接字 + epoll 就绪等待，不占任何额外线程。
+// fd_frames 为 true 时收发 CAN-FD 帧。
+class CoCanSocket
+{
+public:
+    CoCanSocket(EpollExecutor& ex, const std::string& interface, bool fd_frames = false)
+        : ex_(ex), fd_frames_(fd_frames)
+    {
+        fd_ = ::socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, CAN_RAW);
+        if (fd_ < 0) throw CommunicationException("CoCanSocket: socket() failed");
+        ifreq ifr{};
+        std::strncpy(ifr.ifr_name, interface.c_str(), IFNAMSIZ - 1);
+        if (::ioctl(fd_, SIOCGIFINDEX, &ifr) < 0) {
+            ::close(fd_);
+            throw CommunicationException("CoCanSocket: unknown interface " + interface);
+        }
+        if (fd_frames_) {
+            int on = 1;
+            ::setsockopt(fd_, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &on, sizeof(on));
+        }
+        sockaddr_can addr{};
+        addr.can_family = AF_CAN;
+        addr.can_ifindex = ifr.ifr_ifindex;
+        if (::bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            ::close(fd_);
+            throw CommunicationException("CoCanSocket: bind failed on " + interface);
+        }
+    }
+
+    ~CoCanSocket()
+    {
+        if (fd_ < 0) return;
+        ex_.forget(fd_);
+        ::close(fd_);
+    }
+
+    CoCanSocket(const CoCanSocket&) = delete;
+    CoCanSocket& operator=(const CoCanSocket&) = delete;
+
+    int fd() const { return fd_; }
+
+    // 返回的 can_dlc 为实际字节数
+    Task<communication::CanFDFrame> recv()
+    {
+        canfd_frame raw{};
+        while (true) {
+            const ssize_t n = ::read(fd_, &raw, sizeof(raw));
+            if (n == static_cast<ssize_t>(CAN_MTU) || n == static_cast<ssize_t>(CANFD_MTU)) break;
+            if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                throw CommunicationException(std::string("CoCanSocket: read: ") + std::strerror(errno));
+            }
+            co_await ex_.readable(fd_);
+        }
+        communication::CanFDFrame f{};
+        f.valid = true;
+        f.extern_flag = static_cast<uint8_t>((raw.can_id & CAN_EFF_FLAG) ? 1 : 0);
+        f.can_id = raw.can_id & (f.extern_flag ? CAN_EFF_MASK : CAN_SFF_MASK);
+        f.can_dlc = raw.len;
+        std::memcpy(f.data, raw.data, raw.len);
+        co_return f;
+    }
+
+    Task<void> send(std::vector<uint8_t> data, uint32_t can_id, bool extended = false)
+    {
+        canfd_frame raw{};
+        raw.can_id = extended ? ((can_id & CAN_EFF_MASK) | CAN_EFF_FLAG) : (can_id & CAN_SFF_MASK);
+        const size_t max_len = fd_frames_ ? CANFD_MAX_DLEN : CAN_MAX_DLEN;
+        raw.len = static_cast<uint8_t>(data.size() > max_len ? max_len : data.size());
+        std::memcpy(raw.data, data.data(), raw.len);
+        const size_t mtu = (fd_frames_ && raw.len > CAN_MAX_DLEN) ? CANFD_MTU : CAN_MTU;
+        while (::write(fd_, &raw, mtu) < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != ENOBUFS && errno != EINTR) {
+                throw CommunicationException(std::string("CoCanSocket: write: ") + std::strerror(errno));
+            }
+            co_await ex_.writable(fd_);
+        }
+    }
+
+private:
+    EpollExecutor& ex_;
+    bool fd_frames_;
+    int fd_ = -1;
+};
+
+// 现有阻塞接口的协程适配：调用在执行器的阻塞线程上完成。
+// 阻塞的 recv / transact 会一直占住所在线程，因此每个适配器构造时为执行器追加一个阻塞线程，
+// 线程数随端点数增长；只有 CoCanSocket 做到全部手只用执行器一个线程。
+class CoCanBus
+{
+public:
+    CoCanBus(EpollExecutor& ex, communication::ICanBus& bus) : ex_(ex), bus_(bus) { ex_.addBlockingThreads(1); }
+    Task<CANFrame> recv() { co_return co_await ex_.offload([this] { return bus_.recv(); }); }
+    void send(const std::vector<uint8_t>& data, uint32_t can_id) { bus_.send(data, can_id); }
+
+private:
+    EpollExecutor& ex_;
+    communication::ICanBus& bus_;
+};
+
+class CoCanFD
+{
+public:
+    CoCanFD(EpollExecutor& ex, communication::ICanFD& bus, int timeout_ms = 100)
+        : ex_(ex), bus_(bus), timeout_ms_(timeout_ms)
+    {
+        ex_.addBlockingThreads(1);
+    }
+    Task<communication::CanFDFrame> recv()
+    {
+        co_return co_await ex_.offload([this] { return bus_.recv(timeout_ms_); });
+    }
+    void send(const std::vector<uint8_t>& data, uint32_t can_id, bool is_extended = true)
+    {
+        bus_.send(data, can_id, is_extended);
+    }
+
+private:
+    EpollExecutor& ex_;
+    communication::ICanFD& bus_;
+    int timeout_ms_;
+};
+
+class CoModbus
+{
+public:
+    CoModbus(EpollExecutor& ex, communication::IModbus& modbus) : ex_(ex), modbus_(modbus)
+    {
+        ex_.addBlockingThreads(1);
+    }
+
+    // 返回 response 长度，失败 -1（与 IModbus::transact 一致）
+    Task<int> transact(const uint8_t* request, size_t request_len,
+                       uint8_t* response, size_t max_response_len, int timeout_ms = 500)
+    {
+        co_return co_await ex_.offload([=, this] {
+            return modbus_.transact(request, request_len, response, max_response_len, timeout_ms);
+        });
+    }
+
+private:
+    EpollExecutor& ex_;
+    communication::IModbus& modbus_;
+};
+
+}  // namespace coro
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_HAS_COROUTINES
+
+#endif  // LINKERHAND_COROUTINE_H
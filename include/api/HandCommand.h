@@ -0,0 +1,109 @@
+#ifndef LINKERHAND_HAND_COMMAND_H
+#define LINKERHAND_HAND_COMMAND_H
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "LinkerHandApi.h"
+
+namespace linkerhand {
+namespace api {
+
+// 组合运动指令。空向量表示该项不变。
+struct HandCommand {
+    std::vector<uint8_t> position;
+    std::vector<uint8_t> speed;
+    std::vector<uint8_t> torque;
+};
+
+// 无状态版本：按 速度 → 力矩 → 位置 的顺序一次性下发，保证新位置按新的速度/力矩执行。
+inline void setCommand(LinkerHandApi& hand, const HandCommand& cmd)
+{
+    if (!cmd.speed.empty())    hand.setSpeed(cmd.speed);
+    if (!cmd.torque.empty())   hand.setTorque(cmd.torque);
+    if (!cmd.position.empty()) hand.setPosition(cmd.position);
+}
+
+// 带去重的组合指令下发。
+//
+// 协议里速度、力矩、位置各自有独立命令字（O20 则是独立 CAN ID），每帧只承载一种命令，
+// 无法把三者合进同一帧；SDK 发送队列又对每帧节流（经典 CAN 约 1~5ms/帧）。
+// 因此"最少帧数"的做法是：速度/力矩与上次下发完全相同时不再发送，每次运动更新
+// 通常只剩位置帧；三项在同一次持锁中入队，帧在总线上连续、不被其他线程的请求插队。
+class CommandWriter
+{
+public:
+    struct Stats {
+        uint64_t commands = 0;  // setCommand 调用次数
+        uint64_t issued   = 0;  // 实际调用的 setter 次数
+        uint64_t skipped  = 0;  // 因与上次相同而省去的 setter 次数
+    };
+
+    // api_mutex：与其他线程（如 PollScheduler::apiMutex()）共用的 LinkerHandApi 锁，可为空
+    explicit CommandWriter(LinkerHandApi& hand, std::mutex* api_mutex = nullptr)
+        : hand_(hand), api_mutex_(api_mutex ? api_mutex : &own_api_mutex_) {}
+
+    CommandWriter(const CommandWriter&) = delete;
+    CommandWriter& operator=(const CommandWriter&) = delete;
+
+    // 返回本次实际下发的 setter 数
+    size_t setCommand(const HandCommand& cmd)
+    {
+        std::lock_guard<std::mutex> lk(*api_mutex_);
+        ++stats_.commands;
+        size_t n = 0;
+        if (!cmd.speed.empty()) {
+            if (cmd.speed != last_speed_) {
+                hand_.setSpeed(cmd.speed);
+                last_speed_ = cmd.speed;
+                ++n;
+            } else {
+                ++stats_.skipped;
+            }
+        }
+        if (!cmd.torque.empty()) {
+            if (cmd.torque != last_torque_) {
+                hand_.setTorque(cmd.torque);
+                last_torque_ = cmd.torque;
+                ++n;
+            } else {
+                ++stats_.skipped;
+            }
+        }
+        // 位置不去重：重发同一目标可用于把被外力推开的手指拉回
+        if (!cmd.position.empty()) {
+            hand_.setPosition(cmd.position);
+            ++n;
+        }
+        stats_.issued += n;
+        return n;
+    }
+
+    // 忘记已下发的速度/力矩（重连、上电复位后调用，下一次必定重发）
+    void invalidate()
+    {
+        std::lock_guard<std::mutex> lk(*api_mutex_);
+        last_speed_.clear();
+        last_torque_.clear();
+    }
+
+    Stats stats() const
+    {
+        std::lock_guard<std::mutex> lk(*api_mutex_);
+        return stats_;
+    }
+
+private:
+    LinkerHandApi& hand_;
+    mutable std::mutex own_api_mutex_;
+    std::mutex* api_mutex_;
+    std::vector<uint8_t> last_speed_;
+    std::vector<uint8_t> last_torque_;
+    Stats stats_;
+};
+
+}  // namespace api
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_HAND_COMMAND_H
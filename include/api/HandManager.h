@@ -0,0 +1,412 @@
+#ifdef __linux__
+#ifndef LINKERHAND_HAND_MANAGER_H
+#define LINKERHAND_HAND_MANAGER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "LinkerHandApi.h"
+#include "PollScheduler.h"
+#include "communication/CanBusDemux.h"
+#include "communication/IFrameLink.h"
+#include "communication/SocketCanLink.h"
+#include "core/ErrorCode.h"
+#include "core/ThreadConfig.h"
+
+namespace linkerhand {
+namespace api {
+
+struct HandSpec {
+    LINKER_HAND model     = L10;
+    HAND_TYPE   side      = HAND_TYPE::RIGHT;
+    std::string interface = "can0";
+    bool        poll      = true;   // 为该手创建 PollScheduler，由管理器的事件循环驱动
+};
+
+struct HandManagerConfig {
+    size_t   workers         = 1;       // 接收线程数，链路按加入顺序轮流分配
+    // 回读线程数，各手的调度器按加入顺序轮流分配。SDK getter 会阻塞调用线程（L21/L25 的 getPosition
+    // 约 30ms、getForce 约 40ms），同一回读线程上的手串行执行，回读频率受其总耗时限制；
+    // 要求各手互不影响时设为手数
+    size_t   poll_workers    = 1;
+    size_t   rx_queue        = 1024;    // 每只手的接收队列帧数，满时丢弃最旧的帧
+    std::chrono::milliseconds rx_wait{20};  // SDK 接收线程在空队列上的最长等待
+    uint32_t bitrate         = 1000000; // 经典 CAN 波特率（O20 另按 5M 数据段计）
+    double   bus_utilization = 0.5;     // 同一总线上全部手的回读预算之和
+    // 实时配置：SDK 收发线程、接收线程与回读线程的调度 / 亲和性 / 名字（名字后加序号）、mlockall、忙轮询
+    RealTimeConfig rt;
+};
+
+struct HandLinkStats {
+    uint64_t rx_frames  = 0;
+    uint64_t tx_frames  = 0;
+    uint64_t rx_dropped = 0;  // 接收队列溢出丢弃的帧
+    uint64_t tx_errors  = 0;
+};
+
+// 多手管理器：持有若干条链路与 N 个 LinkerHandApi，所有链路的接收与全部手的回读调度
+// 都由少量事件循环线程经 epoll 统一驱动。接收与回读分属两组线程：回读调度器在 processEvents()
+// 中同步调用 SDK getter，可能阻塞数十毫秒，不能让它拖住链路的 pump()，否则同一线程上其他手的
+// 接收队列会溢出，本手 getter 等待的应答也收不到。
+//
+// 同一网卡上的手共用一个套接字，由 CanBusDemux 按 CAN ID（O20 按设备号）把帧分发到各手的端点队列，
+// SDK 内部接收线程调用 RX 回调时从端点取帧，不再各自阻塞在套接字上；
+// 回读调度器以事件循环模式运行（pollFd + processEvents），不再每手一个线程。
+// 同一总线上的手平分 bus_utilization 预算。除 SDK 库内部为每个 LinkerHandApi 启动的线程外，
+// 管理器只增加 workers + poll_workers 个线程。
+class HandManager
+{
+public:
+    explicit HandManager(const HandManagerConfig& config = HandManagerConfig()) : config_(config)
+    {
+        if (config_.workers == 0 || config_.poll_workers == 0 || config_.rx_queue == 0) {
+            throw InvalidParameterException("HandManager: workers, poll_workers and rx_queue must be positive");
+        }
+        if (config_.rt.lock_memory) {
+            const std::error_code ec = lockProcessMemory();
+            if (ec) throw HandException(HandError::OperationFailed, "HandManager: mlockall failed: " + ec.message());
+        }
+        workers_.resize(config_.workers + config_.poll_workers);
+        for (auto& w : workers_) {
+            w.reset(new Worker);
+            w->epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+            w->wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (w->epoll_fd < 0 || w->wake_fd < 0) {
+                closeWorkers();
+                throw HandException(HandError::OperationFailed, "HandManager: epoll/eventfd failed");
+            }
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.ptr = nullptr;  // 唤醒事件
+            ::epoll_ctl(w->epoll_fd, EPOLL_CTL_ADD, w->wake_fd, &ev);
+        }
+        running_ = true;
+        for (size_t i = 0; i < workers_.size(); ++i) {
+            Worker* wp = workers_[i].get();
+            const bool rx = i < config_.workers;
+            const ThreadConfig tc = rx ? config_.rt.worker.named(std::to_string(i))
+                                       : config_.rt.poller.named(std::to_string(i - config_.workers));
+            // 回读线程上的 getter 本就阻塞，不参与忙轮询
+            const int timeout = rx && config_.rt.busy_poll.count() > 0 ? 0 : -1;
+            wp->thread = std::thread([this, wp, tc, timeout] {
+                if (!tc.empty()) noteRealtimeError(applyToCurrentThread(tc));
+                run(*wp, timeout);
+            });
+        }
+    }
+
+    ~HandManager()
+    {
+        stop();
+        std::lock_guard<std::mutex> lk(mutex_);
+        hands_.clear();  // 调度器 → LinkerHandApi → 端点
+        links_.clear();  // 解复用器 → 链路
+        closeWorkers();
+    }
+
+    HandManager(const HandManager&) = delete;
+    HandManager& operator=(const HandManager&) = delete;
+
+    // 按网卡名加入一只手。同一网卡只打开一个 SocketCAN 套接字，各手按 CAN ID（O20 按设备号）分流；
+    // 网卡上只有经典 CAN 手时，内核侧只放行这些手的 CAN ID。
+    size_t addHand(const HandSpec& spec)
+    {
+        const bool fd = spec.model == O20;
+        std::lock_guard<std::mutex> lk(mutex_);
+        Link* link = nullptr;
+        for (const auto& l : links_) {
+            if (l->socket != nullptr && l->socket->interface() == spec.interface) link = l.get();
+        }
+        if (link != nullptr && link->socket->fdFrames() != fd) {
+            throw InvalidParameterException("HandManager::addHand: " + spec.interface
+                                            + " already carries hands with a different frame format");
+        }
+        if (link == nullptr) {
+            std::unique_ptr<communication::SocketCanLink> socket(new communication::SocketCanLink(spec.interface, fd));
+            communication::SocketCanLink* raw = socket.get();
+            link = addLinkLocked(std::move(socket));
+            link->socket = raw;
+            if (config_.rt.busy_poll.count() > 0) raw->setBusyPoll(static_cast<unsigned>(config_.rt.busy_poll.count()));
+        }
+        auto ep = fd ? link->demux->openDevice(spec.side == HAND_TYPE::RIGHT ? 0x01 : 0x02)
+                     : link->demux->open(static_cast<uint32_t>(spec.side));
+        if (link->demux->hasExtendedRoutes()) {
+            link->socket->setFilter({});
+        } else {
+            link->socket->setFilter(link->demux->standardIds());
+        }
+        return addHandLocked(spec.model, spec.side, std::move(ep), spec.interface, spec.poll);
+    }
+
+    // 加入一只手，链路由调用方提供（例如自定义传输或测试替身），该链路上的全部帧都交给这只手。
+    // bus 相同的手共享总线预算。
+    size_t addHand(LINKER_HAND model, HAND_TYPE side, std::unique_ptr<communication::IFrameLink> link,
+                   const std::string& bus, bool poll = true)
+    {
+        if (!link) throw InvalidParameterException("HandManager::addHand: null link");
+        std::lock_guard<std::mutex> lk(mutex_);
+        Link* l = addLinkLocked(std::move(link));
+        return addHandLocked(model, side, l->demux->openDefault(), bus, poll);
+    }
+
+    // 停止事件循环（之后不再收帧与回读）；析构时自动调用
+    void stop()
+    {
+        if (!running_.exchange(false)) return;
+        for (auto& w : workers_) {
+            const uint64_t one = 1;
+            ssize_t n = ::write(w->wake_fd, &one, sizeof(one));
+            (void)n;
+        }
+        for (auto& w : workers_) {
+            if (w->thread.joinable()) w->thread.join();
+        }
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return hands_.size();
+    }
+
+    LinkerHandApi& hand(size_t i) { return *handAt(i).api; }
+
+    // poll = false 的手返回 nullptr。调度器与本手的 RX/TX 在事件循环线程中运行，
+    // 其他线程调用 LinkerHandApi 前请持有 poller(i)->lockApi()。
+    PollScheduler* poller(size_t i) { return handAt(i).poller.get(); }
+
+    HandLinkStats stats(size_t i)
+    {
+        Hand& h = handAt(i);
+        const communication::CanEndpointStats es = h.endpoint->stats();
+        HandLinkStats s;
+        s.rx_frames  = es.rx_frames;
+        s.tx_frames  = es.tx_frames;
+        s.rx_dropped = es.rx_dropped;
+        s.tx_errors  = h.tx_errors.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    // 管理器自身的线程数（接收 + 回读，不含 SDK 库内部线程）
+    size_t threadCount() const { return workers_.size(); }
+
+    // 第一个实时配置失败的错误（例如缺少 CAP_SYS_NICE 时设置 SCHED_FIFO 返回 EPERM）；
+    // SDK 线程的配置在其首次调用回调时套用，因此可能在 addHand() 之后才出现
+    std::error_code realtimeError() const
+    {
+        {
+            std::lock_guard<std::mutex> lk(rt_mutex_);
+            if (rt_error_) return rt_error_;
+        }
+        std::lock_guard<std::mutex> lk(mutex_);
+        for (const auto& h : hands_) {
+            if (h->binder && h->binder->error()) return h->binder->error();
+        }
+        return std::error_code();
+    }
+
+    // 实际打开的链路数（同一网卡上的手共用一条）
+    size_t linkCount() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return links_.size();
+    }
+
+private:
+    struct Link;
+    struct Hand;
+    struct Worker {
+        int epoll_fd = -1;
+        int wake_fd = -1;
+        std::thread thread;
+    };
+
+    // epoll 事件源：链路（link 非空）或某只手的调度定时器
+    struct Source {
+        Link* link = nullptr;
+        Hand* hand = nullptr;
+    };
+
+    struct Link {
+        std::unique_ptr<communication::CanBusDemux> demux;
+        communication::SocketCanLink* socket = nullptr;  // 按网卡名打开的链路，供复用与内核过滤
+        Source src;
+    };
+
+    struct Hand {
+        LINKER_HAND model = L10;
+        std::string bus;
+        Source timer_src;
+        std::shared_ptr<communication::CanEndpoint> endpoint;
+        std::atomic<uint64_t> tx_errors{0};
+        std::unique_ptr<SdkThreadBinder> binder;  // SDK 内部线程的实时配置
+
+        std::unique_ptr<LinkerHandApi> api;
+        std::unique_ptr<PollScheduler> poller;  // 最先析构
+    };
+
+    Link* addLinkLocked(std::unique_ptr<communication::IFrameLink> link)
+    {
+        std::unique_ptr<Link> l(new Link);
+        l->demux.reset(new communication::CanBusDemux(std::move(link), demuxConfig()));
+        l->src.link = l.get();
+        Worker& w = *workers_[links_.size() % config_.workers];
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.ptr = &l->src;
+        if (::epoll_ctl(w.epoll_fd, EPOLL_CTL_ADD, l->demux->fd(), &ev) != 0) {
+            throw HandException(HandError::OperationFailed, "HandManager::addHand: epoll_ctl failed");
+        }
+        links_.push_back(std::move(l));
+        return links_.back().get();
+    }
+
+    size_t addHandLocked(LINKER_HAND model, HAND_TYPE side, std::shared_ptr<communication::CanEndpoint> ep,
+                         const std::string& bus, bool poll)
+    {
+        std::unique_ptr<Hand> h(new Hand);
+        h->model = model;
+        h->bus = bus;
+        h->endpoint = std::move(ep);
+        h->timer_src.hand = h.get();
+
+        Hand* hp = h.get();
+        CanTxCallback ep_tx = h->endpoint->txCallback();
+        CanTxCallback tx = [hp, ep_tx](uint32_t can_id, const uint8_t* data, uintptr_t len) -> int32_t {
+            const int32_t r = ep_tx(can_id, data, len);
+            if (r != 0) hp->tx_errors.fetch_add(1, std::memory_order_relaxed);
+            return r;
+        };
+        CanRxCallback rx = h->endpoint->rxCallback();
+        {
+            ThreadCapture capture;
+            h->api.reset(new LinkerHandApi(model, side));
+            if (!config_.rt.sdk_rx.empty() || !config_.rt.sdk_tx.empty()) {
+                const std::string n = std::to_string(hands_.size());
+                h->binder.reset(new SdkThreadBinder(capture.created(), config_.rt.sdk_rx.named(n),
+                                                    config_.rt.sdk_tx.named(n)));
+                tx = h->binder->wrapTx(tx);
+                rx = h->binder->wrapRx(rx);
+            }
+        }
+        h->api->setCanTxCallback(tx);
+        // 事件循环已在运行：O20 在 setCanRxCallback 内探测手型，需要应答能及时到达
+        h->api->setCanRxCallback(rx);
+        if (poll) {
+            h->poller.reset(new PollScheduler(*h->api, model));
+            h->poller->setRawTx(tx);
+            Worker& w = *workers_[config_.workers + hands_.size() % config_.poll_workers];
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.ptr = &h->timer_src;
+            ::epoll_ctl(w.epoll_fd, EPOLL_CTL_ADD, h->poller->pollFd(), &ev);
+        }
+        hands_.push_back(std::move(h));
+        rebalanceLocked(bus);
+        return hands_.size() - 1;
+    }
+
+    communication::CanDemuxConfig demuxConfig() const
+    {
+        communication::CanDemuxConfig c;
+        c.queue = config_.rx_queue;
+        c.recv_wait = config_.rx_wait;
+        c.busy_poll = config_.rt.busy_poll;
+        return c;
+    }
+
+    void noteRealtimeError(const std::error_code& ec)
+    {
+        if (!ec) return;
+        std::lock_guard<std::mutex> lk(rt_mutex_);
+        if (!rt_error_) rt_error_ = ec;
+    }
+
+    Hand& handAt(size_t i)
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (i >= hands_.size()) throw InvalidParameterException("HandManager: hand index out of range");
+        return *hands_[i];
+    }
+
+    // 同一总线上启用回读的手平分预算
+    void rebalanceLocked(const std::string& bus)
+    {
+        size_t n = 0;
+        for (const auto& h : hands_) n += (h->bus == bus && h->poller) ? 1 : 0;
+        if (n == 0) return;
+        for (const auto& h : hands_) {
+            if (h->bus != bus || !h->poller) continue;
+            PollBudget b;
+            b.timing.nominal_bitrate = config_.bitrate;
+            if (h->model == O20) {
+                b.timing.fd = true;
+                b.timing.data_bitrate = 5000000;
+                b.extended_id = true;
+            }
+            b.max_utilization = config_.bus_utilization / static_cast<double>(n);
+            h->poller->setBudget(b);
+        }
+    }
+
+    // 接收线程只有链路事件，回读线程只有调度定时器事件；timeout 为 0 即忙轮询
+    void run(Worker& w, int timeout)
+    {
+        epoll_event events[64];
+        while (running_) {
+            const int n = ::epoll_wait(w.epoll_fd, events, 64, timeout);
+            for (int i = 0; i < n && running_; ++i) {
+                auto* src = static_cast<Source*>(events[i].data.ptr);
+                if (src == nullptr) {
+                    uint64_t v = 0;
+                    ssize_t r = ::read(w.wake_fd, &v, sizeof(v));
+                    (void)r;
+                    continue;
+                }
+                if (src->link != nullptr) {
+                    src->link->demux->pump();
+                    continue;
+                }
+                try {
+                    src->hand->poller->processEvents();
+                } catch (const std::exception&) {
+                    // 单只手的调度异常不影响同一循环中的其他手
+                }
+            }
+        }
+    }
+
+    void closeWorkers()
+    {
+        for (auto& w : workers_) {
+            if (w->epoll_fd >= 0) ::close(w->epoll_fd);
+            if (w->wake_fd >= 0) ::close(w->wake_fd);
+            w->epoll_fd = w->wake_fd = -1;
+        }
+    }
+
+    HandManagerConfig config_;
+    mutable std::mutex mutex_;   // 保护 hands_ 与 links_
+    std::vector<std::unique_ptr<Link>> links_;
+    std::vector<std::unique_ptr<Hand>> hands_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<bool> running_{false};
+    mutable std::mutex rt_mutex_;
+    std::error_code rt_error_;
+};
+
+}  // namespace api
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_HAND_MANAGER_H
+#endif  // __linux__
@@ -0,0 +1,149 @@
+#ifndef LINKERHAND_HAND_STATE_H
+#define LINKERHAND_HAND_STATE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace linkerhand {
+namespace api {
+
+// 回读通道。顺序即调度表与时间戳数组下标，新增通道只能追加在 Count 之前。
+enum class PollChannel : uint8_t {
+    Position,
+    Speed,
+    Torque,
+    Temperature,
+    FaultCode,
+    Force,
+    PalmForce,
+    NormalForce,       // 五指法向压力
+    TangentialForce,   // 五指切向压力
+    TangentialDir,     // 五指切向压力方向
+    Proximity,         // 五指接近感应
+    Count
+};
+
+constexpr size_t kPollChannelCount = static_cast<size_t>(PollChannel::Count);
+
+inline const char* pollChannelName(PollChannel ch)
+{
+    switch (ch) {
+        case PollChannel::Position:    return "position";
+        case PollChannel::Speed:       return "speed";
+        case PollChannel::Torque:      return "torque";
+        case PollChannel::Temperature: return "temperature";
+        case PollChannel::FaultCode:   return "fault";
+        case PollChannel::Force:       return "force";
+        case PollChannel::PalmForce:   return "palm";
+        case PollChannel::NormalForce:     return "normal";
+        case PollChannel::TangentialForce: return "tangential";
+        case PollChannel::TangentialDir:   return "direction";
+        case PollChannel::Proximity:       return "proximity";
+        default:                       return "unknown";
+    }
+}
+
+// 固定容量：覆盖当前全部型号（L25 25 关节、O20 回读 17；触觉最大 6x12；掌心 TSSP_JZG 20x28）
+constexpr size_t kMaxJoints      = 32;
+constexpr size_t kMaxFingers     = 5;
+constexpr size_t kMaxTaxelRows   = 12;
+constexpr size_t kMaxTaxelCols   = 12;
+constexpr size_t kMaxFingerCells = kMaxFingers * kMaxTaxelRows * kMaxTaxelCols;
+constexpr size_t kMaxPalmCells   = 20 * 28;
+
+// 单通道采样元信息
+struct ChannelStamp {
+    uint64_t sequence = 0;  // 该通道第几个新样本（收到新应答或值变化才递增），0 表示尚无数据
+    int64_t  recv_ns  = 0;  // 应答到达时刻，steady_clock 纳秒；未接 RX 回调时为回读完成时刻
+    uint64_t publish  = 0;  // 写入时的全局发布序号，同号即同一次发布
+};
+
+struct JointSample {
+    uint8_t count = 0;
+    uint8_t values[kMaxJoints] = {};
+};
+
+// 每指一个量（法向 / 切向 / 方向 / 接近），按拇指到小指排列
+struct FingerSample {
+    uint8_t count = 0;
+    uint8_t values[kMaxFingers] = {};
+};
+
+// 行优先：cells[(f * rows + r) * cols + c]
+struct FingerTactileSample {
+    uint8_t fingers = 0;
+    uint8_t rows    = 0;
+    uint8_t cols    = 0;
+    uint8_t cells[kMaxFingerCells] = {};
+};
+
+struct PalmTactileSample {
+    uint8_t rows = 0;
+    uint8_t cols = 0;
+    uint8_t cells[kMaxPalmCells] = {};
+};
+
+// 整手状态快照。调用方自备存储（栈上或常驻成员），读取不分配内存。
+struct HandState {
+    uint64_t publish = 0;  // 快照对应的全局发布序号
+    JointSample position;
+    JointSample speed;
+    JointSample torque;
+    JointSample temperature;
+    JointSample fault;
+    FingerTactileSample force;
+    PalmTactileSample   palm;
+    FingerSample normal;
+    FingerSample tangential;
+    FingerSample direction;
+    FingerSample proximity;
+    ChannelStamp stamps[kPollChannelCount];
+
+    const ChannelStamp& stamp(PollChannel ch) const { return stamps[static_cast<size_t>(ch)]; }
+};
+
+inline void assignJoints(JointSample& dst, const std::vector<uint8_t>& src)
+{
+    dst.count = static_cast<uint8_t>(std::min(src.size(), kMaxJoints));
+    std::memcpy(dst.values, src.data(), dst.count);
+}
+
+inline void assignFingers(FingerSample& dst, const std::vector<uint8_t>& src)
+{
+    dst.count = static_cast<uint8_t>(std::min(src.size(), kMaxFingers));
+    std::memcpy(dst.values, src.data(), dst.count);
+}
+
+inline void assignFingerTactile(FingerTactileSample& dst, const std::vector<uint8_t>& flat,
+                                size_t fingers, size_t rows, size_t cols)
+{
+    if (fingers > kMaxFingers || rows > kMaxTaxelRows || cols > kMaxTaxelCols
+        || fingers * rows * cols != flat.size()) {
+        dst.fingers = dst.rows = dst.cols = 0;
+        return;
+    }
+    dst.fingers = static_cast<uint8_t>(fingers);
+    dst.rows    = static_cast<uint8_t>(rows);
+    dst.cols    = static_cast<uint8_t>(cols);
+    std::memcpy(dst.cells, flat.data(), flat.size());
+}
+
+inline void assignPalmTactile(PalmTactileSample& dst, const std::vector<uint8_t>& flat,
+                              size_t rows, size_t cols)
+{
+    if (rows * cols != flat.size() || flat.size() > kMaxPalmCells) {
+        dst.rows = dst.cols = 0;
+        return;
+    }
+    dst.rows = static_cast<uint8_t>(rows);
+    dst.cols = static_cast<uint8_t>(cols);
+    std::memcpy(dst.cells, flat.data(), flat.size());
+}
+
+}  // namespace api
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_HAND_STATE_H
@@ -0,0 +1,814 @@
+#ifndef LINKERHAND_POLL_SCHEDULER_H
+#define LINKERHAND_POLL_SCHEDULER_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+#include "LinkerHandApi.h"
+#include "HandState.h"
+#include "RequestPlan.h"
+#include "StateSubscription.h"
+#include "communication/CanBusLoad.h"
+#include "core/Seqlock.h"
+#include "core/ThreadConfig.h"
+
+namespace linkerhand {
+namespace api {
+
+// 单次轮询在总线上产生的帧：请求帧 tx_frames 个（载荷 tx_payload 字节），
+// 应答帧 rx_frames 个（载荷 rx_payload 字节）。
+struct PollChannelCost {
+    uint16_t tx_frames  = 0;
+    uint8_t  tx_payload = 0;
+    uint16_t rx_frames  = 0;
+    uint8_t  rx_payload = 0;
+};
+
+// 各型号的默认帧开销（估算值，协议细节以固件为准；实测不符时用 setChannelCost 覆盖）。
+// 经典 CAN 应答帧首字节为命令字，每帧承载 7 字节关节数据；手指触觉每指的应答帧数取自 tactileFingerFrames()。
+inline PollChannelCost defaultPollChannelCost(LINKER_HAND model, PollChannel ch)
+{
+    size_t joints = 10;
+    switch (model) {
+        case L6:  case O6:  joints = 6;  break;
+        case L7:            joints = 7;  break;
+        case L10:           joints = 10; break;
+        case L20:           joints = 20; break;
+        case G20:           joints = 16; break;
+        case L21: case L25: joints = 25; break;
+        case O20:           joints = 17; break;
+    }
+    const bool fd = (model == O20);
+    const size_t finger_frames = tactileFingerFrames(model);
+    const bool has_palm = (model == L6 || model == O6 || model == G20);
+
+    auto frames = [](size_t bytes, size_t per_frame) {
+        return static_cast<uint16_t>((bytes + per_frame - 1) / per_frame);
+    };
+
+    PollChannelCost c;
+    switch (ch) {
+        case PollChannel::Position:
+        case PollChannel::Speed:
+        case PollChannel::Torque:
+        case PollChannel::Temperature:
+        case PollChannel::FaultCode:
+            if (fd) {
+                c = {1, 1, 1, static_cast<uint8_t>(joints + 1)};
+            } else {
+                const uint16_t n = frames(joints, 7);
+                c = {n, 1, n, 8};
+            }
+            break;
+        case PollChannel::Force:
+            if (fd) {
+                // O20 无经典触觉布局，按每指 72 个单元、每帧 62 字节估算
+                c = {5, 1, static_cast<uint16_t>(5 * frames(72, 62)), 64};
+            } else {
+                // 无经典触觉布局的型号（L20、G20）按每指一帧应答估算
+                c = {5, 1, static_cast<uint16_t>(5 * std::max<size_t>(finger_frames, 1)), 8};
+            }
+            break;
+        case PollChannel::PalmForce:
+            if (has_palm) {
+                c = {1, 1, fd ? frames(20 * 28, 62) : frames(20 * 28, 6), static_cast<uint8_t>(fd ? 64 : 8)};
+            }
+            break;
+        case PollChannel::NormalForce:
+        case PollChannel::TangentialForce:
+        case PollChannel::TangentialDir:
+        case PollChannel::Proximity:
+            // 单字节请求，应答为命令字 + 五指各 1 字节
+            if (!readRequestFrames(model, ch).empty()) c = {1, 1, 1, 6};
+            break;
+        default:
+            break;
+    }
+    return c;
+}
+
+// 通道配置：rate_hz 为期望频率，总线预算不足时按 priority 从低到高降频，最低降到 min_rate_hz。
+// 变化驱动退避：连续 backoff_after 次回读值不变，轮询周期翻倍，最多放大到 max_backoff 倍；
+// 值一旦变化或调用 notifyMotion()，立即恢复原频率。max_backoff <= 1 表示不退避。
+struct PollChannelConfig {
+    bool     enabled       = false;
+    double   rate_hz       = 0.0;
+    double   min_rate_hz   = 0.0;
+    uint8_t  priority      = 0;   // 越大越晚被降频
+    uint16_t backoff_after = 3;
+    uint16_t max_backoff   = 1;
+};
+
+// 每只手的总线预算。同一总线挂多只手时，各手 max_utilization 之和不应超过 1。
+struct PollBudget {
+    communication::CanBitTiming timing;
+    bool   extended_id     = false;
+    double max_utilization = 0.5;
+};
+
+struct PollChannelStats {
+    double   requested_hz = 0.0;  // 配置频率
+    double   scheduled_hz = 0.0;  // 预算裁剪后的调度频率
+    double   effective_hz = 0.0;  // 实测完成频率
+    double   bus_load     = 0.0;  // 按调度频率估算的总线占用（0..1）
+    uint16_t backoff      = 1;    // 当前退避倍数，实际轮询频率 = scheduled_hz / backoff
+    uint64_t polls        = 0;
+    uint64_t failures     = 0;
+};
+
+// 后台回读调度器：按通道频率调用 LinkerHandApi 的 getter，缓存最新结果，
+// 并依据帧长、位填充与波特率估算总线占用，超出预算时自动降频低优先级通道。
+// 每次回读同时经顺序锁发布到 HandState 快照，getState() 不阻塞调度线程；
+// 需要推送的消费者经 subscriptions() 订阅，无需自行轮询 getter。
+//
+// 法向 / 切向 / 方向 / 接近四个单指标量流在 LinkerHandApi 中没有公开 getter：调度器经 setRawTx()
+// 直接发出单帧请求，应答由 wrapRx() / onRx() 在 RX 路径上解析，之后与其他通道一样按各自频率调度、
+// 写入 HandState 并推送。这些通道默认关闭，接好原始收发后再用 setChannelRate() 开启。
+//
+// 两种驱动方式二选一：start() 起后台线程；或不调用 start()，由外部事件循环驱动——
+// 把 pollFd() 加入 epoll（或按 nextDeadline() 设超时），可读/到期时调用 processEvents()。
+//
+// LinkerHandApi 本身不保证多线程并发调用安全；调度器运行时，其他线程调用 setPosition 等
+// 接口前请先持有 lockApi() 返回的锁。
+class PollScheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    PollScheduler(LinkerHandApi& hand, LINKER_HAND model)
+        : hand_(hand), model_(model)
+    {
+        budget_.timing.fd = (model == O20);
+        if (budget_.timing.fd) {
+            budget_.timing.data_bitrate = 5000000;
+            budget_.extended_id = true;
+        }
+        for (size_t i = 0; i < kPollChannelCount; ++i) {
+            slots_[i].cost = defaultPollChannelCost(model, static_cast<PollChannel>(i));
+        }
+        // 默认频率与 web_bridge 一致；掌心点阵帧数多，默认关闭。
+        // 温度/故障码/速度/力矩很少变化，默认开启退避；位置与触觉可能在无指令时被外力改变，不退避。
+        slots_[idx(PollChannel::Position)].config    = {true, 10.0, 2.0, 3, 3, 1};
+        slots_[idx(PollChannel::Speed)].config       = {true, 5.0, 0.5, 1, 3, 8};
+        slots_[idx(PollChannel::Torque)].config      = {true, 5.0, 0.5, 1, 3, 8};
+        slots_[idx(PollChannel::Temperature)].config = {true, 1.0, 0.2, 0, 3, 8};
+        slots_[idx(PollChannel::FaultCode)].config   = {true, 1.0, 0.2, 0, 3, 8};
+        slots_[idx(PollChannel::Force)].config       = {true, 30.0, 2.0, 2, 3, 1};
+        slots_[idx(PollChannel::PalmForce)].config   = {false, 5.0, 1.0, 1, 3, 1};
+        for (size_t k = 0; k < kStreamCount; ++k) {
+            const auto ch = static_cast<PollChannel>(idx(PollChannel::NormalForce) + k);
+            slots_[idx(ch)].config = {false, 100.0, 10.0, 2, 3, 1};
+            const auto plan = readRequestFrames(model, ch);
+            if (!plan.empty()) stream_req_[k] = plan.front();
+        }
+        // 应答命令字 -> 通道，供 onRx() 给每个通道记下最近一次应答的到达时刻
+        reply_channel_.fill(kNoChannel);
+        for (size_t i = 0; i < kPollChannelCount; ++i) {
+            for (const auto& f : readRequestFrames(model, static_cast<PollChannel>(i))) {
+                reply_channel_[f.data[0]] = static_cast<uint8_t>(i);
+            }
+        }
+        can_id_ = static_cast<uint32_t>(hand.handType_);
+        rebalanceLocked();
+    }
+
+    ~PollScheduler()
+    {
+        stop();
+#ifdef __linux__
+        if (timer_fd_ >= 0) ::close(timer_fd_);
+#endif
+    }
+
+    PollScheduler(const PollScheduler&) = delete;
+    PollScheduler& operator=(const PollScheduler&) = delete;
+
+    void setChannel(PollChannel ch, const PollChannelConfig& config)
+    {
+        if (ch >= PollChannel::Count || config.rate_hz < 0.0 || config.min_rate_hz < 0.0) {
+            throw InvalidParameterException("PollScheduler::setChannel: invalid channel config");
+        }
+        std::lock_guard<std::mutex> lk(mutex_);
+        slots_[idx(ch)].config = config;
+        rebalanceLocked();
+        rearmLocked();
+        cv_.notify_all();
+    }
+
+    // 仅改频率（web_bridge 的 "R <chan> <hz>" 语义）
+    void setChannelRate(PollChannel ch, double hz)
+    {
+        if (ch >= PollChannel::Count || hz < 0.0) {
+            throw InvalidParameterException("PollScheduler::setChannelRate: invalid rate");
+        }
+        std::lock_guard<std::mutex> lk(mutex_);
+        auto& c = slots_[idx(ch)].config;
+        c.rate_hz = hz;
+        c.enabled = hz > 0.0;
+        if (c.min_rate_hz > hz) c.min_rate_hz = hz;
+        rebalanceLocked();
+        rearmLocked();
+        cv_.notify_all();
+    }
+
+    void setChannelCost(PollChannel ch, const PollChannelCost& cost)
+    {
+        if (ch >= PollChannel::Count) throw InvalidParameterException("PollScheduler::setChannelCost: invalid channel");
+        std::lock_guard<std::mutex> lk(mutex_);
+        slots_[idx(ch)].cost = cost;
+        rebalanceLocked();
+    }
+
+    void setBudget(const PollBudget& budget)
+    {
+        if (budget.max_utilization <= 0.0 || budget.timing.nominal_bitrate == 0) {
+            throw InvalidParameterException("PollScheduler::setBudget: invalid budget");
+        }
+        std::lock_guard<std::mutex> lk(mutex_);
+        budget_ = budget;
+        rebalanceLocked();
+        rearmLocked();
+        cv_.notify_all();
+    }
+
+    // thread 为调度线程的调度配置，在线程启动时套用，失败见 threadError()
+    void start(const ThreadConfig& thread = ThreadConfig())
+    {
+        if (running_.exchange(true)) return;
+#ifdef __linux__
+        {
+            // 线程模式下 timerfd 不再由 processEvents 维护，先解除，避免外部 epoll 空转
+            std::lock_guard<std::mutex> lk(mutex_);
+            armTimerLocked(Clock::time_point::max());
+        }
+#endif
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            const auto now = Clock::now();
+            for (auto& s : slots_) s.next_due = now;
+        }
+        worker_ = std::thread([this, thread] {
+            thread_result_.apply(thread);
+            run();
+        });
+    }
+
+    std::error_code threadError() const { return thread_result_.error(); }
+
+    void stop()
+    {
+        if (!running_.exchange(false)) return;
+        { std::lock_guard<std::mutex> lk(mutex_); }  // 与 run() 的判断-等待配对，避免丢失唤醒
+        cv_.notify_all();
+        if (worker_.joinable()) worker_.join();
+    }
+
+    bool isRunning() const { return running_.load(); }
+
+    // 事件循环模式：执行所有已到期的通道后立即返回，不睡眠；返回本次执行的回读次数。
+    // 与 start() 互斥。
+    size_t processEvents()
+    {
+        if (running_) {
+            throw HandException(HandError::InvalidState,
+                                "PollScheduler::processEvents: scheduler thread is running");
+        }
+#ifdef __linux__
+        if (timer_fd_ >= 0) {
+            uint64_t expirations = 0;
+            ssize_t n = ::read(timer_fd_, &expirations, sizeof(expirations));
+            (void)n;
+        }
+#endif
+        std::unique_lock<std::mutex> lk(mutex_);
+        size_t polled = 0;
+        Clock::time_point deadline;
+        // 上限防止 getter 慢于调度周期时在此处无限循环
+        while (polled < 2 * kPollChannelCount && pollOneDue(lk, deadline)) ++polled;
+        if (polled == 2 * kPollChannelCount) deadline = Clock::now();
+#ifdef __linux__
+        armTimerLocked(deadline);
+#endif
+        return polled;
+    }
+
+    // 最早到期时刻；无启用通道时为 time_point::max()
+    Clock::time_point nextDeadline() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return earliestDueLocked();
+    }
+
+#ifdef __linux__
+    // 可读即有通道到期的 timerfd（CLOCK_MONOTONIC，非阻塞），由调度器持有并关闭。
+    // 首次调用时创建并按当前调度表布防，之后每次 processEvents() 重新布防。
+    int pollFd()
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (timer_fd_ < 0) {
+            timer_fd_ = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+            if (timer_fd_ < 0) {
+                throw HandException(HandError::OperationFailed, "PollScheduler::pollFd: timerfd_create failed");
+            }
+            if (!running_) armTimerLocked(earliestDueLocked());
+        }
+        return timer_fd_;
+    }
+#endif
+
+    LINKER_HAND model() const { return model_; }
+
+    // 单指标量流的原始发送函数（不经 SDK 队列），与 API 调用同在 apiMutex() 下执行
+    void setRawTx(CanTxCallback tx)
+    {
+        std::lock_guard<std::mutex> lk(api_mutex_);
+        raw_tx_ = std::move(tx);
+    }
+
+    // RX 回调收到一帧后调用（单一 RX 线程）：记下所属通道的应答时刻，
+    // 并解析单指标量流应答。解析出单指标量流应答返回 true
+    bool onRx(uint32_t can_id, const uint8_t* data, size_t len)
+    {
+        if (can_id != can_id_ || len < 1) return false;
+        const uint8_t ch = reply_channel_[data[0]];
+        if (ch == kNoChannel) return false;
+        const bool stream = ch >= idx(PollChannel::NormalForce) && ch <= idx(PollChannel::Proximity);
+        if (stream && len < 1 + kMaxFingers) return false;
+        const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now().time_since_epoch()).count();
+        rx_.update([&](RxCache& c) {
+            if (stream) std::memcpy(c.values[ch - idx(PollChannel::NormalForce)], data + 1, kMaxFingers);
+            ++c.received[ch];
+            c.recv_ns[ch] = now;
+        });
+        return stream;
+    }
+
+    // 包装原始 RX 回调，返回可直接交给 LinkerHandApi::setCanRxCallback 的回调
+    CanRxCallback wrapRx(CanRxCallback rx)
+    {
+        return [this, rx = std::move(rx)](uint32_t* can_id, uint8_t* data, uint8_t* len) -> int32_t {
+            const int32_t rc = rx(can_id, data, len);
+            if (rc == 0) onRx(*can_id, data, *len);
+            return rc;
+        };
+    }
+
+    // 与调度线程互斥地访问 LinkerHandApi
+    std::unique_lock<std::mutex> lockApi() { return std::unique_lock<std::mutex>(api_mutex_); }
+    // 供其他组件（如 AsyncHand）共用同一把 API 锁
+    std::mutex& apiMutex() { return api_mutex_; }
+
+    // 下发运动指令后调用：所有退避中的通道立即恢复原频率并尽快回读一次
+    void notifyMotion()
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        const auto now = Clock::now();
+        for (auto& s : slots_) {
+            if (s.backoff > 1) {
+                s.backoff = 1;
+                s.next_due = now;
+            }
+            s.stable_count = 0;
+        }
+        rearmLocked();
+        cv_.notify_all();
+    }
+
+    // 持锁执行一条指令并通知调度器，例如
+    //   poller.command([&](LinkerHandApi& h) { h.setPosition(pose); });
+    template <typename Fn>
+    void command(Fn&& fn)
+    {
+        {
+            std::lock_guard<std::mutex> lk(api_mutex_);
+            fn(hand_);
+        }
+        notifyMotion();
+    }
+
+    // 取某通道最新回读（按行优先展平；触觉为 指×行×列）。从未成功回读返回 false。
+    bool latest(PollChannel ch, std::vector<uint8_t>& out) const
+    {
+        if (ch >= PollChannel::Count) throw InvalidParameterException("PollScheduler::latest: invalid channel");
+        std::lock_guard<std::mutex> lk(mutex_);
+        const auto& s = slots_[idx(ch)];
+        if (s.polls == 0) return false;
+        out = s.data;
+        return true;
+    }
+
+    // 把最新整手状态拷进调用方提供的结构体：不分配、不加锁，读不到撕裂数据。
+    void getState(HandState& out) const { state_.load(out); }
+
+    // 全局发布序号，可用于判断是否有新数据
+    uint64_t stateVersion() const { return state_.version(); }
+
+    // 新样本推送：回调 / StateWaiter / eventfd，按订阅者节流
+    StateSubscriptionHub& subscriptions() { return hub_; }
+
+    PollChannelStats stats(PollChannel ch) const
+    {
+        if (ch >= PollChannel::Count) throw InvalidParameterException("PollScheduler::stats: invalid channel");
+        std::lock_guard<std::mutex> lk(mutex_);
+        const auto& s = slots_[idx(ch)];
+        PollChannelStats st;
+        st.requested_hz = s.config.enabled ? s.config.rate_hz : 0.0;
+        st.scheduled_hz = s.scheduled_hz;
+        st.effective_hz = effectiveHzLocked(s, Clock::now());
+        st.bus_load     = s.scheduled_hz * s.frame_seconds;
+        st.backoff      = s.backoff;
+        st.polls        = s.polls;
+        st.failures     = s.failures;
+        return st;
+    }
+
+    // 按配置频率估算的总线占用（未裁剪）
+    double demandedUtilization() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        double u = 0.0;
+        for (const auto& s : slots_) {
+            if (s.config.enabled) u += s.config.rate_hz * s.frame_seconds;
+        }
+        return u;
+    }
+
+    // 按调度频率估算的总线占用
+    double scheduledUtilization() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return scheduledLoadLocked();
+    }
+
+    // 所有通道降到下限仍超预算
+    bool overBudget() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return scheduledLoadLocked() > budget_.max_utilization + 1e-9;
+    }
+
+private:
+    struct Slot {
+        PollChannelConfig config;
+        PollChannelCost   cost;
+        double            frame_seconds = 0.0;  // 单次轮询的总线时间
+        double            scheduled_hz  = 0.0;
+        Clock::time_point next_due{};
+        Clock::time_point last_done{};
+        double            ema_interval  = 0.0;  // 相邻两次完成的间隔（秒），指数平滑
+        uint64_t          polls         = 0;
+        uint64_t          failures      = 0;
+        uint64_t          samples       = 0;    // 已发布的新样本数，即 ChannelStamp::sequence
+        uint64_t          replies_seen  = 0;    // 上次发布时的 RX 应答帧计数
+        uint16_t          stable_count  = 0;    // 连续未变化次数
+        uint16_t          backoff       = 1;
+        std::vector<uint8_t> data;
+    };
+
+    // 按回读值是否变化更新退避倍数
+    static void updateBackoff(Slot& s, bool changed)
+    {
+        if (changed) {
+            s.stable_count = 0;
+            s.backoff = 1;
+            return;
+        }
+        if (s.config.max_backoff <= 1) return;
+        if (++s.stable_count >= s.config.backoff_after) {
+            s.stable_count = 0;
+            s.backoff = static_cast<uint16_t>(std::min<uint32_t>(s.backoff * 2u, s.config.max_backoff));
+        }
+    }
+
+    static size_t idx(PollChannel ch) { return static_cast<size_t>(ch); }
+
+    Clock::time_point earliestDueLocked() const
+    {
+        auto deadline = Clock::time_point::max();
+        for (const auto& s : slots_) {
+            if (s.scheduled_hz > 0.0 && s.next_due < deadline) deadline = s.next_due;
+        }
+        return deadline;
+    }
+
+    // 事件循环模式下配置变化后重新布防 timerfd；线程模式由条件变量唤醒，无需处理
+    void rearmLocked()
+    {
+#ifdef __linux__
+        if (running_ || timer_fd_ < 0) return;
+        armTimerLocked(earliestDueLocked());
+#endif
+    }
+
+    double scheduledLoadLocked() const
+    {
+        double u = 0.0;
+        for (const auto& s : slots_) u += s.scheduled_hz * s.frame_seconds;
+        return u;
+    }
+
+    static double effectiveHzLocked(const Slot& s, Clock::time_point now)
+    {
+        if (s.polls < 2 || s.ema_interval <= 0.0) return 0.0;
+        const double since = std::chrono::duration<double>(now - s.last_done).count();
+        // 长时间没有新完成时按实际空档衰减，避免停掉的通道一直报旧频率
+        const double interval = since > 2.0 * s.ema_interval ? since : s.ema_interval;
+        return 1.0 / interval;
+    }
+
+    // 重新计算各通道调度频率：总需求超预算时，从最低优先级开始按比例压向 min_rate_hz。
+    void rebalanceLocked()
+    {
+        for (auto& s : slots_) {
+            const double tx = communication::frameSeconds(s.cost.tx_payload, budget_.extended_id, budget_.timing);
+            const double rx = communication::frameSeconds(s.cost.rx_payload, budget_.extended_id, budget_.timing);
+            s.frame_seconds = s.cost.tx_frames * tx + s.cost.rx_frames * rx;
+            s.scheduled_hz = s.config.enabled ? s.config.rate_hz : 0.0;
+        }
+
+        std::array<uint8_t, kPollChannelCount> prios{};
+        for (size_t i = 0; i < kPollChannelCount; ++i) prios[i] = slots_[i].config.priority;
+        std::sort(prios.begin(), prios.end());
+        const auto prio_end = std::unique(prios.begin(), prios.end());
+
+        for (auto p = prios.begin(); p != prio_end; ++p) {
+            const double excess = scheduledLoadLocked() - budget_.max_utilization;
+            if (excess <= 0.0) break;
+
+            double reducible = 0.0;
+            for (const auto& s : slots_) {
+                if (s.config.enabled && s.config.priority == *p) {
+                    const double floor_hz = std::min(s.config.min_rate_hz, s.config.rate_hz);
+                    reducible += (s.scheduled_hz - floor_hz) * s.frame_seconds;
+                }
+            }
+            if (reducible <= 0.0) continue;
+
+            const double keep = reducible <= excess ? 0.0 : 1.0 - excess / reducible;
+            for (auto& s : slots_) {
+                if (s.config.enabled && s.config.priority == *p) {
+                    const double floor_hz = std::min(s.config.min_rate_hz, s.config.rate_hz);
+                    s.scheduled_hz = floor_hz + (s.scheduled_hz - floor_hz) * keep;
+                }
+            }
+        }
+    }
+
+    static constexpr size_t  kStreamCount = 4;  // NormalForce .. Proximity
+    static constexpr uint8_t kNoChannel   = 0xff;
+
+    // RX 路径上的应答记录，RX 线程写、调度线程读：各通道应答帧计数与最近到达时刻，
+    // 以及单指标量流的最新值
+    struct RxCache {
+        uint8_t  values[kStreamCount][kMaxFingers];
+        uint64_t received[kPollChannelCount];
+        int64_t  recv_ns[kPollChannelCount];
+    };
+
+    // 发出下一次请求，并取上一次已到达的应答（与 SDK getter 的缓存语义一致）
+    bool readStream(PollChannel ch, std::vector<uint8_t>& out)
+    {
+        const size_t k = idx(ch) - idx(PollChannel::NormalForce);
+        const RequestFrame& req = stream_req_[k];
+        if (req.len == 0) throw UnsupportedFeatureException(pollChannelName(ch));
+        if (!raw_tx_ || raw_tx_(can_id_, req.data, req.len) != 0) return false;
+        rx_.load(rx_snap_);
+        if (rx_snap_.received[idx(ch)] == 0) return false;
+        out.assign(rx_snap_.values[k], rx_snap_.values[k] + kMaxFingers);
+        return true;
+    }
+
+    // 执行一次 getter，结果按行优先展平；shape 为 {指, 行, 列}（掌心为 {1, 行, 列}）
+    bool readChannel(PollChannel ch, std::vector<uint8_t>& out, std::array<size_t, 3>& shape)
+    {
+        std::lock_guard<std::mutex> lk(api_mutex_);
+        shape = {1, 1, 0};
+        switch (ch) {
+            case PollChannel::NormalForce:
+            case PollChannel::TangentialForce:
+            case PollChannel::TangentialDir:
+            case PollChannel::Proximity:
+                if (!readStream(ch, out)) return false;
+                break;
+            case PollChannel::Position:    out = hand_.getPosition();    break;
+            case PollChannel::Speed:       out = hand_.getSpeed();       break;
+            case PollChannel::Torque:      out = hand_.getTorque();      break;
+            case PollChannel::Temperature: out = hand_.getTemperature(); break;
+            case PollChannel::FaultCode:   out = hand_.getFaultCode();   break;
+            case PollChannel::Force: {
+                const auto cube = hand_.getForce();
+                out.clear();
+                for (const auto& m : cube) for (const auto& r : m) out.insert(out.end(), r.begin(), r.end());
+                shape[0] = cube.size();
+                shape[1] = cube.empty() ? 0 : cube[0].size();
+                shape[2] = (cube.empty() || cube[0].empty()) ? 0 : cube[0][0].size();
+                break;
+            }
+            case PollChannel::PalmForce: {
+                const auto mat = hand_.getPalmForce();
+                out.clear();
+                for (const auto& r : mat) out.insert(out.end(), r.begin(), r.end());
+                shape[1] = mat.size();
+                shape[2] = mat.empty() ? 0 : mat[0].size();
+                break;
+            }
+            default:
+                return false;
+        }
+        // getter 返回的是 SDK 缓存里已到达的应答，此刻的 RX 记录即其到达时刻
+        if (ch < PollChannel::NormalForce) rx_.load(rx_snap_);
+        if (shape[2] == 0) shape[2] = out.size();
+        return !out.empty();
+    }
+
+    // 把一次回读写入快照（仅调度线程调用，满足顺序锁单写者约束）
+    void publish(PollChannel ch, const std::vector<uint8_t>& data, const std::array<size_t, 3>& shape,
+                 uint64_t sequence, int64_t recv_ns)
+    {
+        state_.update([&](HandState& st) {
+            ++st.publish;
+            switch (ch) {
+                case PollChannel::Position:    assignJoints(st.position, data);    break;
+                case PollChannel::Speed:       assignJoints(st.speed, data);       break;
+                case PollChannel::Torque:      assignJoints(st.torque, data);      break;
+                case PollChannel::Temperature: assignJoints(st.temperature, data); break;
+                case PollChannel::FaultCode:   assignJoints(st.fault, data);       break;
+                case PollChannel::Force:
+                    assignFingerTactile(st.force, data, shape[0], shape[1], shape[2]);
+                    break;
+                case PollChannel::PalmForce:
+                    assignPalmTactile(st.palm, data, shape[1], shape[2]);
+                    break;
+                case PollChannel::NormalForce:     assignFingers(st.normal, data);     break;
+                case PollChannel::TangentialForce: assignFingers(st.tangential, data); break;
+                case PollChannel::TangentialDir:   assignFingers(st.direction, data);  break;
+                case PollChannel::Proximity:       assignFingers(st.proximity, data);  break;
+                default:
+                    break;
+            }
+            auto& stamp = st.stamps[idx(ch)];
+            stamp.sequence = sequence;
+            stamp.recv_ns  = recv_ns;
+            stamp.publish  = st.publish;
+        });
+    }
+
+    // 执行最多一个到期通道。没有到期通道时返回 false，并通过 next_deadline 给出最早到期时刻
+    // （没有任何启用通道时为 time_point::max()）。调用方持有 lk，函数内部会临时释放。
+    bool pollOneDue(std::unique_lock<std::mutex>& lk, Clock::time_point& next_deadline)
+    {
+        size_t next = kPollChannelCount;
+        for (size_t i = 0; i < kPollChannelCount; ++i) {
+            if (slots_[i].scheduled_hz <= 0.0) continue;
+            if (next == kPollChannelCount || slots_[i].next_due < slots_[next].next_due) next = i;
+        }
+        if (next == kPollChannelCount) {
+            next_deadline = Clock::time_point::max();
+            return false;
+        }
+        const auto due = slots_[next].next_due;
+        if (Clock::now() < due) {
+            next_deadline = due;
+            return false;
+        }
+
+        lk.unlock();
+        bool ok = false;
+        bool unsupported = false;
+        try {
+            ok = readChannel(static_cast<PollChannel>(next), buf_, shape_);
+        } catch (const UnsupportedFeatureException&) {
+            unsupported = true;
+        } catch (const std::exception&) {
+            ok = false;
+        }
+        lk.lock();
+
+        auto& s = slots_[next];
+        const auto now = Clock::now();
+        bool fresh = false;
+        if (unsupported) {
+            // 型号不支持的通道直接停掉，不再占用总线预算
+            s.config.enabled = false;
+            rebalanceLocked();
+            return true;
+        }
+        if (ok) {
+            if (s.polls > 0) {
+                const double dt = std::chrono::duration<double>(now - s.last_done).count();
+                s.ema_interval = s.ema_interval > 0.0 ? 0.8 * s.ema_interval + 0.2 * dt : dt;
+            }
+            const bool changed = s.polls == 0 || buf_ != s.data;
+            updateBackoff(s, changed);
+            s.last_done = now;
+            ++s.polls;
+            // 只有收到新应答或缓存值变化才算新样本：时间戳取应答在 RX 路径上的到达时刻，
+            // 未接 wrapRx() / onRx() 时退回本次轮询完成时刻
+            const uint64_t replies = rx_snap_.received[next];
+            fresh = changed || replies != s.replies_seen;
+            if (fresh) {
+                const int64_t recv_ns = replies != s.replies_seen
+                    ? rx_snap_.recv_ns[next]
+                    : std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+                s.replies_seen = replies;
+                publish(static_cast<PollChannel>(next), buf_, shape_, ++s.samples, recv_ns);
+            }
+            s.data.swap(buf_);
+        } else {
+            ++s.failures;
+        }
+        if (s.scheduled_hz > 0.0) {
+            const auto period = std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(s.backoff / s.scheduled_hz));
+            s.next_due = due + period;
+            if (s.next_due < now) s.next_due = now;
+        }
+
+        // 推送放在调度表锁外，回调里可以调用 stats() / setChannelRate() 等接口
+        if (fresh && !hub_.empty()) {
+            lk.unlock();
+            state_.load(notify_state_);
+            hub_.notify(static_cast<PollChannel>(next), notify_state_);
+            lk.lock();
+        }
+        return true;
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lk(mutex_);
+        Clock::time_point deadline;
+        while (running_) {
+            if (pollOneDue(lk, deadline)) continue;
+            if (!running_) break;
+            if (deadline == Clock::time_point::max()) {
+                cv_.wait(lk);
+            } else {
+                cv_.wait_until(lk, deadline);  // 配置变化会提前唤醒并重新选通道
+            }
+        }
+    }
+
+#ifdef __linux__
+    void armTimerLocked(Clock::time_point deadline)
+    {
+        if (timer_fd_ < 0) return;
+        itimerspec spec{};
+        if (deadline != Clock::time_point::max()) {
+            // steady_clock 在 Linux 上即 CLOCK_MONOTONIC；已过期的时刻改成 1ns，0 会解除定时
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+            if (ns <= 0) ns = 1;
+            spec.it_value.tv_sec  = static_cast<time_t>(ns / 1000000000);
+            spec.it_value.tv_nsec = static_cast<long>(ns % 1000000000);
+        }
+        ::timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+    }
+#endif
+
+    LinkerHandApi& hand_;
+    LINKER_HAND    model_;
+
+    mutable std::mutex      mutex_;     // 保护调度表与缓存
+    std::mutex              api_mutex_; // 串行化 LinkerHandApi 调用
+    std::condition_variable cv_;
+    std::atomic<bool>       running_{false};
+    std::thread             worker_;
+    ThreadConfigResult      thread_result_;
+
+    PollBudget budget_;
+    std::array<Slot, kPollChannelCount> slots_;
+    Seqlock<HandState> state_;
+    StateSubscriptionHub hub_;
+    HandState notify_state_;  // 推送用快照副本，仅调度线程访问
+    std::vector<uint8_t> buf_;          // 回读缓冲，仅调度线程访问
+    std::array<size_t, 3> shape_{};
+
+    uint32_t can_id_ = 0;
+    CanTxCallback raw_tx_;              // 受 api_mutex_ 保护
+    std::array<RequestFrame, kStreamCount> stream_req_{};
+    std::array<uint8_t, 256> reply_channel_{};  // 应答命令字 -> 通道，构造后只读
+    Seqlock<RxCache> rx_;
+    RxCache rx_snap_{};                 // 本次回读时的 RX 记录，仅调度线程访问
+#ifdef __linux__
+    int timer_fd_ = -1;
+#endif
+};
+
+}  // namespace api
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_POLL_SCHEDULER_H
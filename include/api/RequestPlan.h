@@ -0,0 +1,162 @@
+#ifndef LINKERHAND_REQUEST_PLAN_H
+#define LINKERHAND_REQUEST_PLAN_H
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+#include "core/Common.h"
+#include "communication/RequestCorrelator.h"
+#include "HandState.h"
+#include "TactileLayout.h"
+
+namespace linkerhand {
+namespace api {
+
+// 单个读请求帧：命令字 + 可选参数，replies 为预期应答帧数
+struct RequestFrame {
+    uint8_t  data[3] = {};
+    uint8_t  len     = 0;
+    uint16_t replies = 1;
+};
+
+// 各型号 getter 发出的读请求帧（经典 CAN，帧 ID 即 HAND_TYPE）。
+// 与 SDK 发送队列实际发出的命令一致，供 RequestCorrelator::request() 绕过队列并发请求。
+// 返回空表示该型号不支持该通道，或协议不是"命令字 + 回显"形式（O20 的命令编码在 CAN ID 中）。
+inline std::vector<RequestFrame> readRequestFrames(LINKER_HAND model, PollChannel ch)
+{
+    auto cmds = [](std::initializer_list<uint8_t> list, uint16_t replies = 1) {
+        std::vector<RequestFrame> out;
+        for (uint8_t c : list) {
+            RequestFrame f;
+            f.data[0] = c;
+            f.len = 1;
+            f.replies = replies;
+            out.push_back(f);
+        }
+        return out;
+    };
+    // 手指触觉：每指一个请求，每行一帧应答（tactileFingerFrames）
+    const auto finger_frames = static_cast<uint16_t>(tactileFingerFrames(model));
+    auto tactile = [](uint8_t arg, uint16_t replies) {
+        std::vector<RequestFrame> out;
+        for (uint8_t c = 0xb1; c <= 0xb5; ++c) {
+            RequestFrame f;
+            f.data[0] = c;
+            f.data[1] = arg;
+            f.len = 2;
+            f.replies = replies;
+            out.push_back(f);
+        }
+        return out;
+    };
+    auto palm = [] {
+        RequestFrame f;
+        f.data[0] = 0xb6;
+        f.data[1] = 0x0a;
+        f.data[2] = 0x0a;
+        f.len = 3;
+        return std::vector<RequestFrame>{f};
+    };
+
+    // 单指标量流：每个命令一帧应答，data[1..5] 为拇指到小指
+    auto stream = [&cmds](uint8_t base, PollChannel c) {
+        return cmds({static_cast<uint8_t>(base + static_cast<uint8_t>(c) - static_cast<uint8_t>(PollChannel::NormalForce))});
+    };
+    if (ch >= PollChannel::NormalForce && ch <= PollChannel::Proximity) {
+        switch (model) {
+            case L7:
+            case L20: return stream(0x20, ch);
+            case L25: return stream(0x90, ch);
+            default:  return {};
+        }
+    }
+
+    switch (model) {
+        case L10:
+            switch (ch) {
+                case PollChannel::Position:    return cmds({0x01, 0x04});
+                case PollChannel::Speed:       return cmds({0x05, 0x06});
+                case PollChannel::Torque:      return cmds({0x02, 0x03});
+                case PollChannel::Temperature: return cmds({0x33, 0x34});
+                case PollChannel::FaultCode:   return cmds({0x35, 0x36});
+                case PollChannel::Force:       return cmds({0x28, 0x29, 0x30, 0x31, 0x32}, finger_frames);
+                default: break;
+            }
+            break;
+        case L7:
+        case L6:
+        case O6:
+            switch (ch) {
+                case PollChannel::Position:    return cmds({0x01});
+                case PollChannel::Speed:       return cmds({0x05});
+                case PollChannel::Torque:      return cmds({0x02});
+                case PollChannel::Temperature: return cmds({0x33});
+                case PollChannel::FaultCode:   return cmds({0x35});
+                case PollChannel::Force:
+                    if (model == L7) return cmds({0x28, 0x29, 0x30, 0x31, 0x32}, finger_frames);
+                    return tactile(model == O6 ? 0xa4 : 0xc6, finger_frames);
+                case PollChannel::PalmForce:
+                    if (model != L7) return palm();
+                    break;
+                default: break;
+            }
+            break;
+        case L20:
+            switch (ch) {
+                case PollChannel::Position:  return cmds({0x01, 0x02, 0x03, 0x04});
+                case PollChannel::Speed:     return cmds({0x05});
+                case PollChannel::FaultCode: return cmds({0x07});
+                default: break;
+            }
+            break;
+        case L21:
+        case L25:
+            switch (ch) {
+                case PollChannel::Position:    return cmds({0x41, 0x42, 0x43, 0x44, 0x45});
+                case PollChannel::Speed:       return cmds({0x49, 0x4a, 0x4b, 0x4c, 0x4d});
+                case PollChannel::Torque:      return cmds({0x51, 0x52, 0x53, 0x54, 0x55});
+                case PollChannel::Temperature: return cmds({0x61, 0x62, 0x63, 0x64, 0x65});
+                case PollChannel::FaultCode:   return cmds({0x59, 0x5a, 0x5b, 0x5c, 0x5d});
+                case PollChannel::Force:       return tactile(0xc6, finger_frames);
+                default: break;
+            }
+            break;
+        case G20:
+            switch (ch) {
+                case PollChannel::Position:    return cmds({0x01, 0x02, 0x03, 0x06});
+                case PollChannel::Speed:       return cmds({0x09, 0x0a, 0x0b, 0x0e});
+                case PollChannel::Torque:      return cmds({0x11, 0x12, 0x13, 0x16});
+                case PollChannel::Temperature: return cmds({0x21, 0x22, 0x23, 0x26});
+                case PollChannel::FaultCode:   return cmds({0x19, 0x1a, 0x1b, 0x1e});
+                default: break;
+            }
+            break;
+        case O20:
+            break;
+    }
+    return {};
+}
+
+// 按该型号全部通道的命令表给出 TX 帧的预期应答帧数，交给 RequestCorrelator::setReplyCounter()，
+// 使经 SDK 队列发出的多帧触觉请求也按实际应答帧数登记。命令表外的单字节命令帧按一帧应答登记。
+inline communication::RequestCorrelator::ReplyCounter requestReplyCounter(LINKER_HAND model)
+{
+    std::vector<RequestFrame> frames;
+    for (size_t i = 0; i < kPollChannelCount; ++i) {
+        const auto ch = readRequestFrames(model, static_cast<PollChannel>(i));
+        frames.insert(frames.end(), ch.begin(), ch.end());
+    }
+    return [frames](uint32_t, const uint8_t* data, size_t len) -> uint16_t {
+        for (const auto& f : frames) {
+            if (f.len == len && std::equal(f.data, f.data + f.len, data)) return f.replies;
+        }
+        return len == 1 ? 1 : 0;
+    };
+}
+
+}  // namespace api
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_REQUEST_PLAN_H
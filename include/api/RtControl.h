@@ -0,0 +1,390 @@
+#ifndef LINKERHAND_RT_CONTROL_H
+#define LINKERHAND_RT_CONTROL_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+#include "ArcConversion.h"
+#include "HandState.h"
+#include "LinkerHandApi.h"
+#include "PollScheduler.h"
+#include "TactileBuffer.h"
+#include "core/ErrorCode.h"
+#include "core/ThreadConfig.h"
+
+namespace linkerhand {
+namespace api {
+
+// 实时路径上的一帧（固定大小，可平凡拷贝）
+struct RtFrame {
+    uint32_t id = 0;
+    uint8_t  len = 0;
+    uint8_t  data[64] = {};
+};
+
+// 位置指令编码表：在非实时阶段用一个临时 LinkerHandApi 探测 SDK 对 setPosition 的编码
+// （两组互不重叠的探测值，逐字节比对出“第几帧第几字节 = 第几个关节”），
+// 之后 encode() 只做模板拷贝与字节填充，不分配、不加锁、不抛异常。
+// 只支持每个关节值都原样落在帧字节上的型号；O20 等做了数值变换的型号，以及 SDK 不编码部分关节的
+// L21 / L25，learn() 抛 UnsupportedFeatureException。
+class PositionEncoder
+{
+public:
+    static constexpr size_t kMaxFrames = 8;
+
+    static PositionEncoder learn(LINKER_HAND model, HAND_TYPE side,
+                                 std::chrono::milliseconds settle = std::chrono::milliseconds(30))
+    {
+        if (model == O20) throw UnsupportedFeatureException("real-time position encoding for O20");
+        const size_t dof = ArcTable::jointCount(model);
+
+        LinkerHandApi probe(model, side);
+        std::mutex mutex;
+        std::vector<RtFrame> captured;
+        std::chrono::steady_clock::time_point last = std::chrono::steady_clock::now();
+        bool armed = false;
+        probe.setCanTxCallback([&](uint32_t id, const uint8_t* data, uintptr_t len) -> int32_t {
+            std::lock_guard<std::mutex> lk(mutex);
+            if (!armed || len > sizeof(RtFrame::data)) return 0;
+            RtFrame f;
+            f.id = id;
+            f.len = static_cast<uint8_t>(len);
+            std::memcpy(f.data, data, len);
+            captured.push_back(f);
+            last = std::chrono::steady_clock::now();
+            return 0;
+        });
+
+        auto capture = [&](uint8_t base) {
+            {
+                std::lock_guard<std::mutex> lk(mutex);
+                captured.clear();
+                armed = true;
+                last = std::chrono::steady_clock::now();
+            }
+            std::vector<uint8_t> pose(dof);
+            for (size_t i = 0; i < dof; ++i) pose[i] = static_cast<uint8_t>(base + i);
+            probe.setPosition(pose);
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+            for (;;) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                std::lock_guard<std::mutex> lk(mutex);
+                const auto now = std::chrono::steady_clock::now();
+                if ((!captured.empty() && now - last >= settle) || now >= deadline) {
+                    armed = false;
+                    return captured;
+                }
+            }
+        };
+        const std::vector<RtFrame> a = capture(10);
+        const std::vector<RtFrame> b = capture(100);
+
+        PositionEncoder enc;
+        enc.dof_ = dof;
+        if (a.empty() || a.size() != b.size() || a.size() > kMaxFrames) {
+            throw UnsupportedFeatureException("real-time position encoding: unexpected frame layout");
+        }
+        std::vector<bool> covered(dof, false);
+        for (size_t k = 0; k < a.size(); ++k) {
+            if (a[k].id != b[k].id || a[k].len != b[k].len) {
+                throw UnsupportedFeatureException("real-time position encoding: unstable frame layout");
+            }
+            enc.tmpl_[k] = a[k];
+            for (size_t j = 0; j < a[k].len; ++j) {
+                if (a[k].data[j] == b[k].data[j]) continue;  // 常量字节（命令字、保留位）
+                const int ia = static_cast<int>(a[k].data[j]) - 10;
+                const int ib = static_cast<int>(b[k].data[j]) - 100;
+                if (ia != ib || ia < 0 || static_cast<size_t>(ia) >= dof) {
+                    throw UnsupportedFeatureException("real-time position encoding: transformed values");
+                }
+                enc.slots_[enc.slot_count_++] = Slot{static_cast<uint8_t>(k), static_cast<uint8_t>(j),
+                                                     static_cast<uint8_t>(ia)};
+                covered[static_cast<size_t>(ia)] = true;
+            }
+        }
+        // 每个关节都必须落在某个字节上，否则 encode() 会悄悄丢掉该关节的指令
+        for (size_t i = 0; i < dof; ++i) {
+            if (!covered[i]) throw UnsupportedFeatureException("real-time position encoding: joint without a slot");
+        }
+        enc.frame_count_ = a.size();
+        return enc;
+    }
+
+    size_t dof() const noexcept { return dof_; }
+    size_t frames() const noexcept { return frame_count_; }
+
+    // 把 dof() 个位置值编码进 out[0 .. frames())；长度不符返回 false
+    bool encode(const uint8_t* pose, size_t n, RtFrame* out) const noexcept
+    {
+        if (n != dof_) return false;
+        for (size_t k = 0; k < frame_count_; ++k) out[k] = tmpl_[k];
+        for (size_t s = 0; s < slot_count_; ++s) {
+            const Slot& sl = slots_[s];
+            out[sl.frame].data[sl.byte] = pose[sl.joint];
+        }
+        return true;
+    }
+
+private:
+    struct Slot {
+        uint8_t frame = 0;
+        uint8_t byte = 0;
+        uint8_t joint = 0;
+    };
+
+    size_t dof_ = 0;
+    size_t frame_count_ = 0;
+    size_t slot_count_ = 0;
+    std::array<RtFrame, kMaxFrames> tmpl_{};
+    std::array<Slot, kMaxFrames * 64> slots_{};
+};
+
+// 单生产者单消费者无锁帧队列：实时线程 push()，发送线程 drain()。
+// Linux 上附带 eventfd（fd()），push 后唤醒发送线程或事件循环；写 eventfd 是一次系统调用，不涉及用户态锁。
+class RtFrameQueue
+{
+public:
+    explicit RtFrameQueue(size_t capacity = 64)
+    {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        ring_.resize(cap);
+        mask_ = cap - 1;
+#ifdef __linux__
+        event_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (event_fd_ < 0) throw HandException(HandError::OperationFailed, "RtFrameQueue: eventfd failed");
+#endif
+    }
+
+    ~RtFrameQueue()
+    {
+#ifdef __linux__
+        if (event_fd_ >= 0) ::close(event_fd_);
+#endif
+    }
+
+    RtFrameQueue(const RtFrameQueue&) = delete;
+    RtFrameQueue& operator=(const RtFrameQueue&) = delete;
+
+    // 一次放入 n 帧（全部放入或都不放）；空间不足返回 false
+    bool push(const RtFrame* frames, size_t n) noexcept
+    {
+        const uint64_t tail = tail_.load(std::memory_order_relaxed);
+        const uint64_t head = head_.load(std::memory_order_acquire);
+        if (tail - head + n > ring_.size()) return false;
+        for (size_t i = 0; i < n; ++i) ring_[(tail + i) & mask_] = frames[i];
+        tail_.store(tail + n, std::memory_order_release);
+#ifdef __linux__
+        const uint64_t one = 1;
+        ssize_t w = ::write(event_fd_, &one, sizeof(one));
+        (void)w;
+#endif
+        return true;
+    }
+
+    // 取出并发送全部待发帧，返回发送的帧数；tx 返回非 0 计入 errors
+    size_t drain(const CanTxCallback& tx, size_t* errors = nullptr)
+    {
+#ifdef __linux__
+        uint64_t v = 0;
+        ssize_t r = ::read(event_fd_, &v, sizeof(v));
+        (void)r;
+#endif
+        const uint64_t tail = tail_.load(std::memory_order_acquire);
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        size_t n = 0;
+        for (; head != tail; ++head, ++n) {
+            const RtFrame& f = ring_[head & mask_];
+            if (tx(f.id, f.data, f.len) != 0 && errors != nullptr) ++*errors;
+            head_.store(head + 1, std::memory_order_release);
+        }
+        return n;
+    }
+
+    size_t size() const noexcept
+    {
+        return static_cast<size_t>(tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire));
+    }
+
+    size_t capacity() const noexcept { return ring_.size(); }
+
+    // 有帧待发时可读（Linux），可放进事件循环；其他平台为 -1
+    int fd() const noexcept { return event_fd_; }
+
+private:
+    std::vector<RtFrame> ring_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<uint64_t> head_{0};
+    alignas(64) std::atomic<uint64_t> tail_{0};
+    int event_fd_ = -1;
+};
+
+struct RtHandStats {
+    uint64_t commands = 0;   // 成功入队的位置指令
+    uint64_t rejected = 0;   // 参数错误或队列满而拒绝的指令
+    uint64_t sent = 0;       // 发送线程已写出的帧
+    uint64_t tx_errors = 0;
+};
+
+// 实时控制面：供硬实时控制循环调用的位置下发与状态 / 触觉读取。
+//
+// 热路径（setPosition / getState / copyTactile / readTactile）均为 noexcept，不分配内存、不加锁，
+// 以 std::error_code（HandError 类别）返回错误：
+//   setPosition  按 PositionEncoder 编码进预分配帧，推入无锁队列，由发送线程（startSender 或调用方的
+//                事件循环经 fd() + drain()）经原始 TX 回调写出，不经 SDK 发送队列；
+//   getState     从 PollScheduler 的顺序锁快照读取；
+//   触觉          从 TactileBuffer 的顺序锁前台帧拷贝或零拷贝读取。
+// 只允许一个线程调用 setPosition（单生产者）。构造、startSender 等准备工作可能分配与抛异常，须在进入实时循环前完成。
+// 可用 core/RtCheck.h 的钩子在测试中统计热路径上的分配与加锁次数。
+class RtHand
+{
+public:
+    RtHand(LINKER_HAND model, HAND_TYPE side, const PollScheduler* poller = nullptr,
+           const TactileBuffer* tactile = nullptr, size_t queue_frames = 64)
+        : encoder_(PositionEncoder::learn(model, side)), queue_(queue_frames), poller_(poller), tactile_(tactile)
+    {
+        if (queue_.capacity() < encoder_.frames()) {
+            throw InvalidParameterException("RtHand: queue smaller than one position command");
+        }
+    }
+
+    ~RtHand() { stopSender(); }
+
+    RtHand(const RtHand&) = delete;
+    RtHand& operator=(const RtHand&) = delete;
+
+    size_t dof() const noexcept { return encoder_.dof(); }
+
+    std::error_code setPosition(const uint8_t* pose, size_t n) noexcept
+    {
+        RtFrame frames[PositionEncoder::kMaxFrames];
+        if (pose == nullptr || !encoder_.encode(pose, n, frames)) {
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            return make_error_code(HandError::InvalidParameter);
+        }
+        if (!queue_.push(frames, encoder_.frames())) {
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            return make_error_code(HandError::Timeout);  // 发送线程跟不上：队列满
+        }
+        commands_.fetch_add(1, std::memory_order_relaxed);
+        return std::error_code();
+    }
+
+    std::error_code getState(HandState& out) const noexcept
+    {
+        if (poller_ == nullptr) return make_error_code(HandError::NotInitialized);
+        poller_->getState(out);
+        return out.publish == 0 ? make_error_code(HandError::InvalidState) : std::error_code();  // 尚无回读
+    }
+
+    // 拷贝最新完整手指 / 掌心触觉帧到调用方缓冲区
+    std::error_code copyFingers(uint8_t* dst, size_t capacity, TactileStamp* stamp = nullptr) const noexcept
+    {
+        if (tactile_ == nullptr) return make_error_code(HandError::NotInitialized);
+        if (tactile_->layout().fingerCells() == 0) return make_error_code(HandError::UnsupportedFeature);
+        return tactile_->copyFingers(dst, capacity, stamp) ? std::error_code()
+                                                           : make_error_code(HandError::OutOfRange);
+    }
+
+    std::error_code copyPalm(uint8_t* dst, size_t capacity, TactileStamp* stamp = nullptr) const noexcept
+    {
+        if (tactile_ == nullptr) return make_error_code(HandError::NotInitialized);
+        if (tactile_->layout().palmCells() == 0) return make_error_code(HandError::UnsupportedFeature);
+        return tactile_->copyPalm(dst, capacity, stamp) ? std::error_code()
+                                                        : make_error_code(HandError::OutOfRange);
+    }
+
+    // 零拷贝读取：fn(const TactileView&) 须为 noexcept，只计算并写出结果，不得把视图带出
+    template <typename Fn>
+    std::error_code readTactile(Fn&& fn) const noexcept
+    {
+        static_assert(noexcept(fn(std::declval<const TactileView&>())), "RtHand::readTactile: fn must be noexcept");
+        if (tactile_ == nullptr) return make_error_code(HandError::NotInitialized);
+        tactile_->read(fn);
+        return std::error_code();
+    }
+
+    // 发送侧（非实时）：由调用方的事件循环在 fd() 可读时调用 drain(tx)，或 startSender() 起一个线程
+    int fd() const noexcept { return queue_.fd(); }
+
+    size_t drain(const CanTxCallback& tx)
+    {
+        size_t errors = 0;
+        const size_t n = queue_.drain(tx, &errors);
+        sent_.fetch_add(n, std::memory_order_relaxed);
+        tx_errors_.fetch_add(errors, std::memory_order_relaxed);
+        return n;
+    }
+
+    // tx 为原始发送函数（例如 CanEndpoint::txCallback() 或 SocketCanLink 写入），thread 为发送线程的调度配置
+    void startSender(CanTxCallback tx, const ThreadConfig& thread = ThreadConfig())
+    {
+        if (sender_running_.exchange(true)) return;
+        sender_ = std::thread([this, tx = std::move(tx), thread] {
+            thread_result_.apply(thread);
+            while (sender_running_.load(std::memory_order_acquire)) {
+#ifdef __linux__
+                pollfd p{queue_.fd(), POLLIN, 0};
+                ::poll(&p, 1, 50);
+#else
+                if (queue_.size() == 0) std::this_thread::sleep_for(std::chrono::microseconds(200));
+#endif
+                drain(tx);
+            }
+        });
+    }
+
+    void stopSender()
+    {
+        if (!sender_running_.exchange(false)) return;
+        if (sender_.joinable()) sender_.join();
+    }
+
+    // 发送线程套用调度配置失败的错误
+    std::error_code threadError() const { return thread_result_.error(); }
+
+    RtHandStats stats() const noexcept
+    {
+        RtHandStats s;
+        s.commands  = commands_.load(std::memory_order_relaxed);
+        s.rejected  = rejected_.load(std::memory_order_relaxed);
+        s.sent      = sent_.load(std::memory_order_relaxed);
+        s.tx_errors = tx_errors_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    PositionEncoder encoder_;
+    RtFrameQueue queue_;
+    const PollScheduler* poller_ = nullptr;
+    const TactileBuffer* tactile_ = nullptr;
+    std::atomic<uint64_t> commands_{0};
+    std::atomic<uint64_t> rejected_{0};
+    std::atomic<uint64_t> sent_{0};
+    std::atomic<uint64_t> tx_errors_{0};
+    std::atomic<bool> sender_running_{false};
+    ThreadConfigResult thread_result_;
+    std::thread sender_;
+};
+
+}  // namespace api
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_RT_CONTROL_H
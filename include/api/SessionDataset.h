@@ -0,0 +1,307 @@
+#ifndef LINKERHAND_SESSION_DATASET_H
+#define LINKERHAND_SESSION_DATASET_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "HandState.h"
+#include "SessionRecorder.h"
+#include "core/ErrorCode.h"
+
+namespace linkerhand {
+namespace api {
+
+// 按时间二分：返回第一个时刻 >= t_ns 的下标
+inline size_t lowerBoundTime(const std::vector<int64_t>& times, int64_t t_ns)
+{
+    return static_cast<size_t>(std::lower_bound(times.begin(), times.end(), t_ns) - times.begin());
+}
+
+// 一个回读通道的全部样本。时间戳连续存放；样本数据不拷贝，row(i) 直接指向映射的文件内容。
+// 形状：关节 / 单指通道 {元素数, 1, 1}；五指触觉 {指, 行, 列}；掌心 {1, 行, 列}。
+// 形状与首个样本不同的样本（换型号、配置变化）不入列，计入 mismatched()。
+class SampleColumn
+{
+public:
+    size_t size() const { return times_.size(); }
+    bool empty() const { return times_.empty(); }
+
+    const std::array<uint8_t, 3>& shape() const { return shape_; }
+    size_t rowBytes() const { return row_bytes_; }
+    uint64_t mismatched() const { return mismatched_; }
+
+    const std::vector<int64_t>& times() const { return times_; }
+    int64_t time(size_t i) const { return times_[i]; }
+    const uint8_t* row(size_t i) const { return base_ + offsets_[i]; }
+
+    // 时刻 t_ns 时有效的样本（最后一个时刻 <= t_ns 的样本）；早于首个样本返回 size()
+    size_t at(int64_t t_ns) const
+    {
+        const size_t i = static_cast<size_t>(std::upper_bound(times_.begin(), times_.end(), t_ns) - times_.begin());
+        return i == 0 ? size() : i - 1;
+    }
+
+    // [t0, t1) 内样本的下标区间
+    std::pair<size_t, size_t> range(int64_t t0, int64_t t1) const
+    {
+        return {lowerBoundTime(times_, t0), lowerBoundTime(times_, t1)};
+    }
+
+    // 把 [begin, end) 拷成连续的 N × rowBytes() 数组，out 至少 (end - begin) * rowBytes() 字节
+    void copyRows(size_t begin, size_t end, uint8_t* out) const
+    {
+        for (size_t i = begin; i < end; ++i, out += row_bytes_) std::memcpy(out, row(i), row_bytes_);
+    }
+
+private:
+    friend class SessionDataset;
+
+    // 解析 State 载荷头，返回形状与数据起始偏移
+    static bool parse(PollChannel ch, const uint8_t* p, size_t len, std::array<uint8_t, 3>& shape, size_t& skip)
+    {
+        if (len == 0) return false;
+        switch (ch) {
+            case PollChannel::Force:
+                if (len < 3) return false;
+                shape = {p[0], p[1], p[2]};
+                skip = 3;
+                break;
+            case PollChannel::PalmForce:
+                if (len < 2) return false;
+                shape = {1, p[0], p[1]};
+                skip = 2;
+                break;
+            default:
+                shape = {p[0], 1, 1};
+                skip = 1;
+                break;
+        }
+        return len >= skip + static_cast<size_t>(shape[0]) * shape[1] * shape[2];
+    }
+
+    void add(PollChannel ch, int64_t t_ns, uint64_t offset, const uint8_t* payload, size_t len)
+    {
+        std::array<uint8_t, 3> shape{};
+        size_t skip = 0;
+        if (!parse(ch, payload, len, shape, skip)) {
+            ++mismatched_;
+            return;
+        }
+        if (times_.empty()) {
+            shape_ = shape;
+            row_bytes_ = static_cast<size_t>(shape[0]) * shape[1] * shape[2];
+        } else if (shape != shape_) {
+            ++mismatched_;
+            return;
+        }
+        times_.push_back(t_ns);
+        offsets_.push_back(offset + skip);
+    }
+
+    const uint8_t* base_ = nullptr;
+    std::array<uint8_t, 3> shape_{};
+    size_t row_bytes_ = 0;
+    uint64_t mismatched_ = 0;
+    std::vector<int64_t>  times_;
+    std::vector<uint64_t> offsets_;
+};
+
+// 同一类收发帧（CanTx / CanRx / ModbusTx / ModbusRx）
+class FrameColumn
+{
+public:
+    size_t size() const { return times_.size(); }
+    bool empty() const { return times_.empty(); }
+
+    const std::vector<int64_t>& times() const { return times_; }
+    int64_t time(size_t i) const { return times_[i]; }
+    uint32_t id(size_t i) const { return ids_[i]; }
+    const uint8_t* data(size_t i) const { return base_ + offsets_[i]; }
+    uint16_t len(size_t i) const { return lens_[i]; }
+
+    std::pair<size_t, size_t> range(int64_t t0, int64_t t1) const
+    {
+        return {lowerBoundTime(times_, t0), lowerBoundTime(times_, t1)};
+    }
+
+private:
+    friend class SessionDataset;
+
+    void add(int64_t t_ns, uint32_t id, uint64_t offset, uint16_t len)
+    {
+        times_.push_back(t_ns);
+        ids_.push_back(id);
+        offsets_.push_back(offset);
+        lens_.push_back(len);
+    }
+
+    const uint8_t* base_ = nullptr;
+    std::vector<int64_t>  times_;
+    std::vector<uint32_t> ids_;
+    std::vector<uint64_t> offsets_;
+    std::vector<uint16_t> lens_;
+};
+
+// 内存映射的会话数据集：打开时扫描一遍记录头，为每个通道建立时间戳列与偏移索引，
+// 之后的访问都直接落在映射内存上，不解析、不拷贝。构建完成后只读，多个线程可同时访问任意列
+// （例如按 range() 切分下标区间并行处理）。非 Linux 平台整体读入内存。
+class SessionDataset
+{
+public:
+    explicit SessionDataset(const std::string& path)
+    {
+        map(path);
+        if (size_ < sizeof(SessionFileHeader)) {
+            unmap();
+            throw InvalidParameterException("session: bad file header");
+        }
+        std::memcpy(&header_, data_, sizeof(header_));
+        if (std::memcmp(header_.magic, "LHRS", 4) != 0 || header_.version != 1
+            || header_.chunk_bytes < sizeof(SessionChunkHeader) || header_.header_bytes < sizeof(header_)) {
+            unmap();
+            throw InvalidParameterException("session: bad file header");
+        }
+        for (auto& c : channels_) c.base_ = data_;
+        for (auto& f : frames_) f.base_ = data_;
+        index();
+    }
+
+    ~SessionDataset() { unmap(); }
+
+    SessionDataset(const SessionDataset&) = delete;
+    SessionDataset& operator=(const SessionDataset&) = delete;
+
+    const SessionFileHeader& header() const { return header_; }
+    int64_t wallTime(int64_t t_ns) const { return header_.wall_ns + (t_ns - header_.steady_ns); }
+
+    const SampleColumn& channel(PollChannel ch) const
+    {
+        if (ch >= PollChannel::Count) throw InvalidParameterException("SessionDataset::channel: invalid channel");
+        return channels_[static_cast<size_t>(ch)];
+    }
+
+    const FrameColumn& frames(SessionRecordType type) const
+    {
+        const int k = frameSlot(type);
+        if (k < 0) throw InvalidParameterException("SessionDataset::frames: not a frame record type");
+        return frames_[k];
+    }
+
+    uint64_t records() const { return records_; }
+    uint64_t droppedRecords() const { return dropped_; }
+    uint64_t corruptChunks() const { return corrupt_; }
+
+private:
+    static int frameSlot(SessionRecordType type)
+    {
+        switch (type) {
+            case SessionRecordType::CanTx:    return 0;
+            case SessionRecordType::CanRx:    return 1;
+            case SessionRecordType::ModbusTx: return 2;
+            case SessionRecordType::ModbusRx: return 3;
+            default:                          return -1;
+        }
+    }
+
+    void index()
+    {
+        const size_t chunk = header_.chunk_bytes;
+        for (uint64_t base = header_.header_bytes; base + chunk <= size_; base += chunk) {
+            SessionChunkHeader ch;
+            std::memcpy(&ch, data_ + base, sizeof(ch));
+            if (std::memcmp(ch.magic, "LHCK", 4) != 0 || ch.used > chunk || ch.used < sizeof(ch)) {
+                ++corrupt_;
+                continue;
+            }
+            dropped_ += ch.dropped;
+            uint64_t off = sizeof(ch);
+            for (uint32_t r = 0; r < ch.records; ++r) {
+                SessionRecordHeader h;
+                if (off + sizeof(h) > ch.used) break;
+                std::memcpy(&h, data_ + base + off, sizeof(h));
+                const uint64_t payload = base + off + sizeof(h);
+                if (off + sizeof(h) + h.len > ch.used) {
+                    ++corrupt_;
+                    break;
+                }
+                const auto type = static_cast<SessionRecordType>(h.type);
+                if (type == SessionRecordType::State) {
+                    if (h.id < kPollChannelCount) {
+                        channels_[h.id].add(static_cast<PollChannel>(h.id), h.t_ns, payload, data_ + payload, h.len);
+                    }
+                } else {
+                    const int k = frameSlot(type);
+                    if (k >= 0) frames_[k].add(h.t_ns, h.id, payload, h.len);
+                }
+                ++records_;
+                off += sizeof(h) + detail::sessionAlign8(h.len);
+            }
+        }
+        if ((size_ - std::min<uint64_t>(size_, header_.header_bytes)) % chunk != 0) ++corrupt_;  // 末块不完整
+    }
+
+#ifdef __linux__
+    void map(const std::string& path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) throw InvalidParameterException("session: cannot open " + path);
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            throw InvalidParameterException("session: cannot stat " + path);
+        }
+        size_ = static_cast<uint64_t>(st.st_size);
+        void* p = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) throw HandException(HandError::OperationFailed, "session: mmap failed for " + path);
+        data_ = static_cast<const uint8_t*>(p);
+    }
+
+    void unmap()
+    {
+        if (data_ != nullptr) ::munmap(const_cast<uint8_t*>(data_), size_);
+        data_ = nullptr;
+    }
+#else
+    void map(const std::string& path)
+    {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) throw InvalidParameterException("session: cannot open " + path);
+        buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        data_ = reinterpret_cast<const uint8_t*>(buffer_.data());
+        size_ = buffer_.size();
+    }
+
+    void unmap() { data_ = nullptr; }
+
+    std::vector<char> buffer_;
+#endif
+
+    const uint8_t* data_ = nullptr;
+    uint64_t size_ = 0;
+    SessionFileHeader header_;
+    std::array<SampleColumn, kPollChannelCount> channels_;
+    std::array<FrameColumn, 4> frames_;
+    uint64_t records_ = 0;
+    uint64_t dropped_ = 0;
+    uint64_t corrupt_ = 0;
+};
+
+}  // namespace api
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_SESSION_DATASET_H
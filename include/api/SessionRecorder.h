@@ -0,0 +1,703 @@
+#ifndef LINKERHAND_SESSION_RECORDER_H
+#define LINKERHAND_SESSION_RECORDER_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "CommunicationCallbacks.h"
+#include "HandState.h"
+#include "StateSubscription.h"
+#include "core/ErrorCode.h"
+#include "core/ThreadConfig.h"
+
+namespace linkerhand {
+namespace api {
+
+// 会话录制文件格式（主机字节序，当前平台均为小端）：
+//   [文件头块 4096B][数据块 0][数据块 1]...
+// 每个数据块定长 chunk_bytes（4096 的整数倍），以块头开始，其后紧跟若干记录，末尾补零。
+// 块之间互相独立，进程崩溃时已落盘的块仍可完整读出。
+// 记录 = 16 字节记录头 + 载荷，载荷补齐到 8 字节边界。
+enum class SessionRecordType : uint8_t {
+    CanTx   = 1,  // 发往总线的帧，id 为 CAN ID
+    CanRx   = 2,  // 从总线收到的帧
+    State   = 3,  // 解析后的通道样本，id 为 PollChannel，载荷见 encodeStateSample()
+    Command = 4,  // API 指令，载荷 = 名称长度(1B) + 名称 + 参数
+    Marker  = 5,  // 文本标记
+    ModbusTx = 6, // 发出的 Modbus RTU 帧，id 为从站地址
+    ModbusRx = 7, // 收到的 Modbus RTU 帧
+};
+
+// CAN 收发帧的记录头 flags：按实际帧格式记录，导出 candump 时原样还原
+constexpr uint8_t kSessionFrameFd  = 0x01;  // CAN FD 帧
+constexpr uint8_t kSessionFrameEff = 0x02;  // 扩展帧（29 位 ID）
+constexpr uint8_t kSessionFrameBrs = 0x04;  // CAN FD 数据段位速率切换
+
+struct SessionFileHeader {
+    char     magic[4]     = {'L', 'H', 'R', 'S'};
+    uint32_t version      = 1;
+    uint32_t header_bytes = 4096;
+    uint32_t chunk_bytes  = 0;
+    int64_t  wall_ns      = 0;  // 开始录制时的 system_clock（导出 candump 时换算绝对时间）
+    int64_t  steady_ns    = 0;  // 同一时刻的 steady_clock，记录时间戳均为 steady_clock 纳秒
+};
+
+struct SessionChunkHeader {
+    char     magic[4] = {'L', 'H', 'C', 'K'};
+    uint32_t used     = 0;  // 含块头的有效字节数
+    uint64_t index    = 0;
+    uint32_t records  = 0;
+    uint32_t dropped  = 0;  // 上一块封存以来因缓冲用尽丢弃的记录数
+    uint64_t reserved = 0;
+};
+
+struct SessionRecordHeader {
+    int64_t  t_ns  = 0;
+    uint32_t id    = 0;
+    uint16_t len   = 0;  // 载荷字节数（不含补齐）
+    uint8_t  type  = 0;
+    uint8_t  flags = 0;
+};
+
+static_assert(sizeof(SessionChunkHeader) == 32, "SessionChunkHeader layout");
+static_assert(sizeof(SessionRecordHeader) == 16, "SessionRecordHeader layout");
+
+namespace detail {
+constexpr size_t kSessionBlock = 4096;
+inline size_t sessionAlign8(size_t n) { return (n + 7) & ~static_cast<size_t>(7); }
+}  // namespace detail
+
+// 通道样本的紧凑编码（State 记录载荷）：
+//   关节 / 单指通道：count + values[count]
+//   五指触觉：fingers + rows + cols + cells
+//   掌心：rows + cols + cells
+// 返回写入的字节数，buf 至少 kMaxStatePayload 字节。
+constexpr size_t kMaxStatePayload = 3 + kMaxFingerCells;
+
+inline size_t encodeStateSample(PollChannel ch, const HandState& st, uint8_t* buf)
+{
+    auto joints = [buf](const JointSample& s) {
+        buf[0] = s.count;
+        std::memcpy(buf + 1, s.values, s.count);
+        return static_cast<size_t>(1 + s.count);
+    };
+    auto fingers = [buf](const FingerSample& s) {
+        buf[0] = s.count;
+        std::memcpy(buf + 1, s.values, s.count);
+        return static_cast<size_t>(1 + s.count);
+    };
+    switch (ch) {
+        case PollChannel::Position:        return joints(st.position);
+        case PollChannel::Speed:           return joints(st.speed);
+        case PollChannel::Torque:          return joints(st.torque);
+        case PollChannel::Temperature:     return joints(st.temperature);
+        case PollChannel::FaultCode:       return joints(st.fault);
+        case PollChannel::NormalForce:     return fingers(st.normal);
+        case PollChannel::TangentialForce: return fingers(st.tangential);
+        case PollChannel::TangentialDir:   return fingers(st.direction);
+        case PollChannel::Proximity:       return fingers(st.proximity);
+        case PollChannel::Force: {
+            const size_t n = static_cast<size_t>(st.force.fingers) * st.force.rows * st.force.cols;
+            buf[0] = st.force.fingers;
+            buf[1] = st.force.rows;
+            buf[2] = st.force.cols;
+            std::memcpy(buf + 3, st.force.cells, n);
+            return 3 + n;
+        }
+        case PollChannel::PalmForce: {
+            const size_t n = static_cast<size_t>(st.palm.rows) * st.palm.cols;
+            buf[0] = st.palm.rows;
+            buf[1] = st.palm.cols;
+            std::memcpy(buf + 2, st.palm.cells, n);
+            return 2 + n;
+        }
+        default:
+            return 0;
+    }
+}
+
+// 把 State 记录载荷写回 HandState 的对应字段；载荷不合法返回 false
+inline bool decodeStateSample(PollChannel ch, const uint8_t* data, size_t len, HandState& st)
+{
+    if (len == 0) return false;
+    auto joints = [&](JointSample& s) {
+        if (data[0] > kMaxJoints || len < 1u + data[0]) return false;
+        s.count = data[0];
+        std::memcpy(s.values, data + 1, s.count);
+        return true;
+    };
+    auto fingers = [&](FingerSample& s) {
+        if (data[0] > kMaxFingers || len < 1u + data[0]) return false;
+        s.count = data[0];
+        std::memcpy(s.values, data + 1, s.count);
+        return true;
+    };
+    switch (ch) {
+        case PollChannel::Position:        return joints(st.position);
+        case PollChannel::Speed:           return joints(st.speed);
+        case PollChannel::Torque:          return joints(st.torque);
+        case PollChannel::Temperature:     return joints(st.temperature);
+        case PollChannel::FaultCode:       return joints(st.fault);
+        case PollChannel::NormalForce:     return fingers(st.normal);
+        case PollChannel::TangentialForce: return fingers(st.tangential);
+        case PollChannel::TangentialDir:   return fingers(st.direction);
+        case PollChannel::Proximity:       return fingers(st.proximity);
+        case PollChannel::Force: {
+            if (len < 3) return false;
+            const size_t n = static_cast<size_t>(data[0]) * data[1] * data[2];
+            if (data[0] > kMaxFingers || data[1] > kMaxTaxelRows || data[2] > kMaxTaxelCols || len < 3 + n) {
+                return false;
+            }
+            st.force.fingers = data[0];
+            st.force.rows    = data[1];
+            st.force.cols    = data[2];
+            std::memcpy(st.force.cells, data + 3, n);
+            return true;
+        }
+        case PollChannel::PalmForce: {
+            if (len < 2) return false;
+            const size_t n = static_cast<size_t>(data[0]) * data[1];
+            if (n > kMaxPalmCells || len < 2 + n) return false;
+            st.palm.rows = data[0];
+            st.palm.cols = data[1];
+            std::memcpy(st.palm.cells, data + 2, n);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+struct SessionRecorderConfig {
+    size_t chunk_bytes = 256 << 10; // 单块大小，向上取 4096 的整数倍
+    size_t chunks      = 8;         // 预分配块数；全部在途时新记录被丢弃并计数
+    // 未写满的块最长滞留时间，到期即封存落盘（低速录制时块内剩余空间以零填充）；0 表示只在写满或 close() 时落盘
+    std::chrono::milliseconds flush_interval{1000};
+    bool   direct_io   = false;     // Linux：以 O_DIRECT 打开，绕过页缓存（块与偏移均按 4096 对齐）
+    ThreadConfig writer_thread;     // 落盘线程的调度配置（通常放到非实时核上），失败见 threadError()
+    // wrapTx / wrapRx 录制帧时附加的 kSessionFrame* 标志。SDK 回调只给 ID 与长度：
+    // 链路以扩展帧或 CAN FD（含 BRS）收发时在此声明；超过 8 字节的帧总记为 FD，ID 超过 11 位的总记为扩展帧。
+    uint8_t link_frame_flags = 0;
+};
+
+struct SessionRecorderStats {
+    uint64_t records      = 0;
+    uint64_t bytes        = 0;  // 已写入文件的字节数
+    uint64_t chunks       = 0;
+    uint64_t dropped      = 0;
+    uint64_t write_errors = 0;
+};
+
+// 会话录制器：收发帧、通道样本、API 指令与文本标记按纳秒时间戳写入分块二进制文件。
+// 记录时只持锁把数据拷进预分配的块，写满（或超过 flush_interval）的块交给后台线程落盘；
+// 控制路径从不等待磁盘，也不分配内存。磁盘跟不上、空闲块用尽时丢弃新记录并计入 dropped。
+class SessionRecorder
+{
+public:
+    explicit SessionRecorder(const std::string& path, const SessionRecorderConfig& config = SessionRecorderConfig())
+        : config_(config)
+    {
+        if (config_.chunks < 2) {
+            throw InvalidParameterException("SessionRecorder: at least 2 chunks required");
+        }
+        const size_t block = detail::kSessionBlock;
+        config_.chunk_bytes = std::max(block, (config_.chunk_bytes + block - 1) / block * block);
+        if (config_.chunk_bytes > UINT32_MAX) {
+            throw InvalidParameterException("SessionRecorder: chunk too large");
+        }
+        openFile(path);
+        pool_.resize(config_.chunks);
+        for (auto& p : pool_) {
+            p = allocBlock(config_.chunk_bytes);
+            free_.push_back(p);
+        }
+
+        header_.chunk_bytes = static_cast<uint32_t>(config_.chunk_bytes);
+        header_.wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        header_.steady_ns = now();
+        uint8_t* first = allocBlock(block);
+        std::memcpy(first, &header_, sizeof(header_));
+        const bool ok = writeBlock(first, block);
+        freeBlock(first);
+        if (!ok) {
+            closeFile();
+            for (auto* p : pool_) freeBlock(p);
+            throw HandException(HandError::OperationFailed, "SessionRecorder: cannot write " + path);
+        }
+        stats_.bytes = block;
+        writer_ = std::thread([this] {
+            thread_result_.apply(config_.writer_thread);
+            run();
+        });
+    }
+
+    ~SessionRecorder()
+    {
+        close();
+        for (auto* p : pool_) freeBlock(p);
+    }
+
+    SessionRecorder(const SessionRecorder&) = delete;
+    SessionRecorder& operator=(const SessionRecorder&) = delete;
+
+    // 封存当前块、等待全部落盘并关闭文件；之后的记录被忽略
+    void close()
+    {
+        detach();
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            if (closed_) return;
+            closed_ = true;
+            sealLocked();
+        }
+        cv_.notify_all();
+        if (writer_.joinable()) writer_.join();
+        closeFile();
+    }
+
+    static int64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // 记录一帧，帧格式取自 SessionRecorderConfig::link_frame_flags 与 ID / 长度
+    bool recordFrame(SessionRecordType dir, uint32_t can_id, const uint8_t* data, size_t len, int64_t t_ns = now())
+    {
+        uint8_t flags = config_.link_frame_flags;
+        if (len > 8) flags |= kSessionFrameFd;
+        if (can_id > 0x7FF) flags |= kSessionFrameEff;
+        return recordFrame(dir, flags, can_id, data, len, t_ns);
+    }
+
+    // 记录一帧，flags（kSessionFrame*）为实际帧格式；自行收发帧的调用方（如 SocketCAN）用此接口
+    bool recordFrame(SessionRecordType dir, uint8_t flags, uint32_t can_id, const uint8_t* data, size_t len,
+                     int64_t t_ns = now())
+    {
+        return append(dir, flags, can_id, data, len, nullptr, 0, t_ns);
+    }
+
+    // 包装收发回调（与 RequestCorrelator 等旁路组件可任意嵌套）
+    CanTxCallback wrapTx(CanTxCallback tx)
+    {
+        return [this, tx = std::move(tx)](uint32_t can_id, const uint8_t* data, uintptr_t len) -> int32_t {
+            recordFrame(SessionRecordType::CanTx, can_id, data, static_cast<size_t>(len));
+            return tx(can_id, data, len);
+        };
+    }
+
+    CanRxCallback wrapRx(CanRxCallback rx)
+    {
+        return [this, rx = std::move(rx)](uint32_t* can_id, uint8_t* data, uint8_t* len) -> int32_t {
+            const int32_t rc = rx(can_id, data, len);
+            if (rc == 0) recordFrame(SessionRecordType::CanRx, *can_id, data, *len);
+            return rc;
+        };
+    }
+
+    ModbusTxCallback wrapModbusTx(ModbusTxCallback tx)
+    {
+        return [this, tx = std::move(tx)](uint8_t slave, uint16_t addr, const uint8_t* data, uintptr_t len) -> int32_t {
+            append(SessionRecordType::ModbusTx, 0, slave, data, static_cast<size_t>(len), nullptr, 0, now());
+            return tx(slave, addr, data, len);
+        };
+    }
+
+    ModbusRxCallback wrapModbusRx(ModbusRxCallback rx)
+    {
+        return [this, rx = std::move(rx)](uint8_t slave, uint16_t* addr, uint8_t* data, uint8_t* len) -> int32_t {
+            const int32_t rc = rx(slave, addr, data, len);
+            if (rc == 0) append(SessionRecordType::ModbusRx, 0, slave, data, *len, nullptr, 0, now());
+            return rc;
+        };
+    }
+
+    // 记录快照中某通道的当前样本，时间戳取该通道的回读时刻
+    bool recordState(PollChannel ch, const HandState& st)
+    {
+        if (ch >= PollChannel::Count) return false;
+        uint8_t buf[kMaxStatePayload];
+        const size_t n = encodeStateSample(ch, st, buf);
+        return append(SessionRecordType::State, 0, static_cast<uint32_t>(ch), buf, n, nullptr, 0,
+                      st.stamp(ch).recv_ns);
+    }
+
+    // 订阅调度器推送，逐个记录新样本；同一时刻只能挂一个 hub
+    void attach(StateSubscriptionHub& hub, uint32_t channel_mask = kAllChannels)
+    {
+        detach();
+        hub_ = &hub;
+        sub_ = hub.subscribe(channel_mask, [this](PollChannel ch, const HandState& st) { recordState(ch, st); });
+    }
+
+    void detach()
+    {
+        if (hub_ == nullptr) return;
+        hub_->unsubscribe(sub_);
+        hub_ = nullptr;
+    }
+
+    // 记录一条 API 指令，例如 recordCommand("setPosition", pose.data(), pose.size())
+    bool recordCommand(const char* name, const uint8_t* args, size_t len)
+    {
+        uint8_t head[256];
+        const size_t n = std::min<size_t>(std::strlen(name), 255);
+        head[0] = static_cast<uint8_t>(n);
+        std::memcpy(head + 1, name, n);
+        return append(SessionRecordType::Command, 0, 0, head, n + 1, args, len, now());
+    }
+
+    bool recordCommand(const char* name, const std::vector<uint8_t>& args)
+    {
+        return recordCommand(name, args.data(), args.size());
+    }
+
+    bool marker(const std::string& text)
+    {
+        return append(SessionRecordType::Marker, 0, 0, text.data(), text.size(), nullptr, 0, now());
+    }
+
+    std::error_code threadError() const { return thread_result_.error(); }
+
+    SessionRecorderStats stats() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return stats_;
+    }
+
+private:
+    bool append(SessionRecordType type, uint8_t flags, uint32_t id, const void* a, size_t alen,
+                const void* b, size_t blen, int64_t t_ns)
+    {
+        const size_t len = alen + blen;
+        const size_t need = sizeof(SessionRecordHeader) + detail::sessionAlign8(len);
+        if (len > UINT16_MAX || sizeof(SessionChunkHeader) + need > config_.chunk_bytes) return false;
+
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (closed_) return false;
+        if (cur_ != nullptr && cur_used_ + need > config_.chunk_bytes) sealLocked();
+        if (cur_ == nullptr) {
+            if (free_.empty()) {
+                ++stats_.dropped;
+                ++pending_dropped_;
+                return false;
+            }
+            cur_ = free_.back();
+            free_.pop_back();
+            cur_used_ = sizeof(SessionChunkHeader);
+            cur_records_ = 0;
+            cur_opened_ = std::chrono::steady_clock::now();
+        }
+        SessionRecordHeader h;
+        h.t_ns  = t_ns;
+        h.id    = id;
+        h.len   = static_cast<uint16_t>(len);
+        h.type  = static_cast<uint8_t>(type);
+        h.flags = flags;
+        uint8_t* p = cur_ + cur_used_;
+        std::memcpy(p, &h, sizeof(h));
+        if (alen) std::memcpy(p + sizeof(h), a, alen);
+        if (blen) std::memcpy(p + sizeof(h) + alen, b, blen);
+        cur_used_ += need;
+        ++cur_records_;
+        ++stats_.records;
+        return true;
+    }
+
+    // 封存当前块：填块头、补零，交给写线程
+    void sealLocked()
+    {
+        if (cur_ == nullptr) return;
+        SessionChunkHeader ch;
+        ch.used    = static_cast<uint32_t>(cur_used_);
+        ch.index   = next_index_++;
+        ch.records = cur_records_;
+        ch.dropped = pending_dropped_;
+        pending_dropped_ = 0;
+        std::memcpy(cur_, &ch, sizeof(ch));
+        std::memset(cur_ + cur_used_, 0, config_.chunk_bytes - cur_used_);
+        full_.push_back(cur_);
+        cur_ = nullptr;
+        cv_.notify_all();
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lk(mutex_);
+        while (true) {
+            if (full_.empty()) {
+                if (closed_) {
+                    // 最后几条记录因缓冲用尽被丢弃时没有后继块携带计数：此时全部块已归还，补封一个空块
+                    if (pending_dropped_ != 0 && !free_.empty()) {
+                        cur_ = free_.back();
+                        free_.pop_back();
+                        cur_used_ = sizeof(SessionChunkHeader);
+                        cur_records_ = 0;
+                        sealLocked();
+                        continue;
+                    }
+                    break;
+                }
+                if (config_.flush_interval.count() > 0) {
+                    // 记录写入不通知写线程；按间隔醒来检查当前块是否到期
+                    const auto now_tp = std::chrono::steady_clock::now();
+                    if (cur_ != nullptr && now_tp >= cur_opened_ + config_.flush_interval) {
+                        sealLocked();
+                        continue;
+                    }
+                    cv_.wait_until(lk, (cur_ != nullptr ? cur_opened_ : now_tp) + config_.flush_interval);
+                } else {
+                    cv_.wait(lk);
+                }
+                continue;
+            }
+            uint8_t* block = full_.front();
+            full_.erase(full_.begin());
+            lk.unlock();
+            const bool ok = writeBlock(block, config_.chunk_bytes);
+            lk.lock();
+            if (ok) {
+                stats_.bytes += config_.chunk_bytes;
+                ++stats_.chunks;
+            } else {
+                ++stats_.write_errors;
+            }
+            free_.push_back(block);
+        }
+    }
+
+    static uint8_t* allocBlock(size_t bytes)
+    {
+        void* p = nullptr;
+#ifdef __linux__
+        if (::posix_memalign(&p, detail::kSessionBlock, bytes) != 0) p = nullptr;
+#else
+        p = std::malloc(bytes);
+#endif
+        if (p == nullptr) throw HandException(HandError::OperationFailed, "SessionRecorder: out of memory");
+        std::memset(p, 0, bytes);
+        return static_cast<uint8_t*>(p);
+    }
+
+    static void freeBlock(uint8_t* p) { std::free(p); }
+
+#ifdef __linux__
+    void openFile(const std::string& path)
+    {
+        int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+        if (config_.direct_io) flags |= O_DIRECT;
+        fd_ = ::open(path.c_str(), flags, 0644);
+        if (fd_ < 0) throw HandException(HandError::OperationFailed, "SessionRecorder: cannot open " + path);
+    }
+
+    bool writeBlock(const uint8_t* p, size_t n)
+    {
+        while (n > 0) {
+            const ssize_t w = ::write(fd_, p, n);
+            if (w <= 0) return false;
+            p += w;
+            n -= static_cast<size_t>(w);
+        }
+        return true;
+    }
+
+    void closeFile()
+    {
+        if (fd_ >= 0) ::close(fd_);
+        fd_ = -1;
+    }
+
+    int fd_ = -1;
+#else
+    void openFile(const std::string& path)
+    {
+        file_ = std::fopen(path.c_str(), "wb");
+        if (file_ == nullptr) throw HandException(HandError::OperationFailed, "SessionRecorder: cannot open " + path);
+    }
+
+    bool writeBlock(const uint8_t* p, size_t n) { return std::fwrite(p, 1, n, file_) == n; }
+
+    void closeFile()
+    {
+        if (file_ != nullptr) std::fclose(file_);
+        file_ = nullptr;
+    }
+
+    std::FILE* file_ = nullptr;
+#endif
+
+    SessionRecorderConfig config_;
+    SessionFileHeader header_;
+
+    mutable std::mutex      mutex_;   // 保护以下全部状态；临界区内只做内存拷贝
+    std::condition_variable cv_;
+    std::vector<uint8_t*>   pool_;    // 全部块，析构时释放
+    std::vector<uint8_t*>   free_;
+    std::vector<uint8_t*>   full_;    // 待落盘，按封存顺序
+    uint8_t*  cur_ = nullptr;
+    size_t    cur_used_ = 0;
+    uint32_t  cur_records_ = 0;
+    uint32_t  pending_dropped_ = 0;
+    uint64_t  next_index_ = 0;
+    bool      closed_ = false;
+    std::chrono::steady_clock::time_point cur_opened_;
+    SessionRecorderStats stats_;
+    std::thread writer_;
+    ThreadConfigResult thread_result_;
+
+    StateSubscriptionHub* hub_ = nullptr;
+    SubscriptionId sub_ = 0;
+};
+
+// 一条已录制的记录；data 指向读取缓冲区，仅在回调内有效
+struct SessionRecord {
+    int64_t           t_ns  = 0;
+    SessionRecordType type  = SessionRecordType::Marker;
+    uint8_t           flags = 0;
+    uint32_t          id    = 0;
+    const uint8_t*    data  = nullptr;
+    uint16_t          len   = 0;
+};
+
+// 顺序读取会话文件。末尾不完整或损坏的块被跳过并计入 corruptChunks()。
+class SessionReader
+{
+public:
+    explicit SessionReader(const std::string& path) : in_(path, std::ios::binary)
+    {
+        if (!in_) throw InvalidParameterException("session: cannot open " + path);
+        in_.read(reinterpret_cast<char*>(&header_), sizeof(header_));
+        if (!in_ || std::memcmp(header_.magic, "LHRS", 4) != 0) {
+            throw InvalidParameterException("session: bad file header");
+        }
+        if (header_.version != 1) throw InvalidParameterException("session: unsupported version");
+        if (header_.chunk_bytes < sizeof(SessionChunkHeader) || header_.header_bytes < sizeof(header_)) {
+            throw InvalidParameterException("session: bad chunk size");
+        }
+        buf_.resize(header_.chunk_bytes);
+    }
+
+    const SessionFileHeader& header() const { return header_; }
+
+    // steady_clock 时间戳换算为 Unix 纳秒
+    int64_t wallTime(int64_t t_ns) const { return header_.wall_ns + (t_ns - header_.steady_ns); }
+
+    // 从头遍历全部记录；fn 返回 false 时提前结束
+    template <typename Fn>
+    void forEach(Fn&& fn)
+    {
+        in_.clear();
+        in_.seekg(header_.header_bytes);
+        dropped_ = 0;
+        corrupt_ = 0;
+        while (in_.read(reinterpret_cast<char*>(buf_.data()), static_cast<std::streamsize>(buf_.size()))) {
+            SessionChunkHeader ch;
+            std::memcpy(&ch, buf_.data(), sizeof(ch));
+            if (std::memcmp(ch.magic, "LHCK", 4) != 0 || ch.used > buf_.size() || ch.used < sizeof(ch)) {
+                ++corrupt_;
+                continue;
+            }
+            dropped_ += ch.dropped;
+            size_t off = sizeof(ch);
+            for (uint32_t r = 0; r < ch.records; ++r) {
+                SessionRecordHeader h;
+                if (off + sizeof(h) > ch.used) break;
+                std::memcpy(&h, buf_.data() + off, sizeof(h));
+                if (off + sizeof(h) + h.len > ch.used) {
+                    ++corrupt_;
+                    break;
+                }
+                SessionRecord rec;
+                rec.t_ns  = h.t_ns;
+                rec.type  = static_cast<SessionRecordType>(h.type);
+                rec.flags = h.flags;
+                rec.id    = h.id;
+                rec.data  = buf_.data() + off + sizeof(h);
+                rec.len   = h.len;
+                if (!fn(static_cast<const SessionRecord&>(rec))) return;
+                off += sizeof(h) + detail::sessionAlign8(h.len);
+            }
+        }
+        if (in_.gcount() > 0) ++corrupt_;  // 末块不完整
+    }
+
+    // 最近一次 forEach 遍历到的丢弃记录数与损坏块数
+    uint64_t droppedRecords() const { return dropped_; }
+    uint64_t corruptChunks() const { return corrupt_; }
+
+private:
+    std::ifstream in_;
+    SessionFileHeader header_;
+    std::vector<uint8_t> buf_;
+    uint64_t dropped_ = 0;
+    uint64_t corrupt_ = 0;
+};
+
+// 导出收发帧为 candump -L 日志格式：(秒.微秒) 接口 ID#数据；CAN FD 帧为 ID##标志数据。
+// 扩展帧 / FD / BRS 取自记录头 flags；扩展帧输出 8 位十六进制 ID。返回导出的帧数。
+inline size_t exportCandump(SessionReader& reader, std::ostream& out, const std::string& iface = "can0")
+{
+    size_t frames = 0;
+    // 时间戳与接口名分开写出，帧部分按最坏情况定长：8 位 ID + "##N" + 64 字节 × 2 + 换行
+    char stamp[48];
+    char frame[8 + 3 + 2 * 64 + 1];
+    reader.forEach([&](const SessionRecord& r) {
+        if (r.type != SessionRecordType::CanTx && r.type != SessionRecordType::CanRx) return true;
+        const int64_t wall = reader.wallTime(r.t_ns);
+        int64_t sec = wall / 1000000000;
+        int64_t usec = (wall % 1000000000) / 1000;
+        if (usec < 0) {
+            --sec;
+            usec += 1000000;
+        }
+        const int m = std::snprintf(stamp, sizeof(stamp), "(%lld.%06lld) ", static_cast<long long>(sec),
+                                    static_cast<long long>(usec));
+        out.write(stamp, m);
+        out.write(iface.data(), static_cast<std::streamsize>(iface.size()));
+        out.put(' ');
+
+        static const char hex[] = "0123456789ABCDEF";
+        size_t n = 0;
+        const bool extended = (r.flags & kSessionFrameEff) != 0;
+        const uint32_t id = r.id & 0x1FFFFFFFu;
+        for (int shift = extended ? 28 : 8; shift >= 0; shift -= 4) frame[n++] = hex[(id >> shift) & 0x0F];
+        frame[n++] = '#';
+        if (r.flags & kSessionFrameFd) {
+            frame[n++] = '#';
+            frame[n++] = (r.flags & kSessionFrameBrs) ? '1' : '0';
+        }
+        const size_t len = std::min<size_t>(r.len, 64);
+        for (size_t i = 0; i < len; ++i) {
+            frame[n++] = hex[r.data[i] >> 4];
+            frame[n++] = hex[r.data[i] & 0x0F];
+        }
+        frame[n++] = '\n';
+        out.write(frame, static_cast<std::streamsize>(n));
+        ++frames;
+        return true;
+    });
+    return frames;
+}
+
+}  // namespace api
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_SESSION_RECORDER_H
@@ -0,0 +1,536 @@
+#ifndef LINKERHAND_SESSION_REPLAY_H
+#define LINKERHAND_SESSION_REPLAY_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "SessionRecorder.h"
+#include "communication/ICanBus.h"
+#include "communication/ICanFD.h"
+#include "communication/IModbus.h"
+#include "core/ErrorCode.h"
+
+namespace linkerhand {
+namespace api {
+
+constexpr uint8_t kReplayFd     = kSessionFrameFd;  // CAN FD 帧
+constexpr uint8_t kReplayTx     = 0x02;             // 录制时由主机发出（回放时默认不投递）
+constexpr uint8_t kReplayModbus = 0x04;             // Modbus RTU 帧，id 为从站地址
+constexpr uint8_t kReplayEff    = 0x08;             // 扩展帧（29 位 ID）
+
+struct ReplayFrame {
+    int64_t  t_ns   = 0;  // 录制时刻（纳秒，单调不减）
+    uint32_t id     = 0;
+    uint32_t offset = 0;  // 载荷在 ReplayLog 字节区中的偏移
+    uint16_t len    = 0;
+    uint8_t  flags  = 0;
+};
+
+// 待回放的帧序列：帧表 + 连续字节区，载荷长度不受 CAN 帧限制（Modbus 帧最长 256 字节）。
+// 加载后只读，可被多个回放传输共享。
+class ReplayLog
+{
+public:
+    void add(int64_t t_ns, uint32_t id, const uint8_t* data, size_t len, uint8_t flags)
+    {
+        if (len > UINT16_MAX) throw InvalidParameterException("ReplayLog: frame too long");
+        ReplayFrame f;
+        // 时间戳回退（多接口合并的日志等）时钳到前一帧，保证回放时钟单调
+        f.t_ns   = frames_.empty() ? t_ns : std::max(t_ns, frames_.back().t_ns);
+        f.id     = id;
+        f.offset = static_cast<uint32_t>(bytes_.size());
+        f.len    = static_cast<uint16_t>(len);
+        f.flags  = flags;
+        bytes_.insert(bytes_.end(), data, data + len);
+        frames_.push_back(f);
+    }
+
+    size_t size() const { return frames_.size(); }
+    bool empty() const { return frames_.empty(); }
+    const ReplayFrame& operator[](size_t i) const { return frames_[i]; }
+    const uint8_t* data(const ReplayFrame& f) const { return bytes_.data() + f.offset; }
+
+    // 首帧到末帧的时长
+    int64_t duration() const { return frames_.empty() ? 0 : frames_.back().t_ns - frames_.front().t_ns; }
+
+    // 会话录制文件（SessionRecorder）：取 CAN 与 Modbus 收发帧
+    static ReplayLog fromSession(const std::string& path)
+    {
+        SessionReader reader(path);
+        ReplayLog log;
+        reader.forEach([&log](const SessionRecord& r) {
+            switch (r.type) {
+                case SessionRecordType::CanRx:    log.add(r.t_ns, r.id, r.data, r.len, canFlags(r)); break;
+                case SessionRecordType::CanTx:    log.add(r.t_ns, r.id, r.data, r.len, canFlags(r) | kReplayTx); break;
+                case SessionRecordType::ModbusRx: log.add(r.t_ns, r.id, r.data, r.len, kReplayModbus); break;
+                case SessionRecordType::ModbusTx: log.add(r.t_ns, r.id, r.data, r.len, kReplayModbus | kReplayTx); break;
+                default: break;
+            }
+            return true;
+        });
+        return log;
+    }
+
+    // candump -L 日志：(秒.微秒) 接口 ID#数据 / ID##标志数据 [T|R]。
+    // 行尾带 T 的帧（candump -x）视为主机发出；远程帧、错误帧与无法解析的行跳过。
+    static ReplayLog fromCandump(std::istream& in)
+    {
+        ReplayLog log;
+        std::string line;
+        std::vector<uint8_t> buf;
+        while (std::getline(in, line)) {
+            std::istringstream ls(line);
+            std::string stamp, iface, frame, dir;
+            if (!(ls >> stamp >> iface >> frame) || stamp.size() < 3 || stamp.front() != '(') continue;
+            ls >> dir;
+            const size_t dot = stamp.find('.');
+            if (dot == std::string::npos) continue;
+            const int64_t sec = std::strtoll(stamp.c_str() + 1, nullptr, 10);
+            std::string frac = stamp.substr(dot + 1, stamp.size() - dot - 2);
+            frac.resize(9, '0');
+            const int64_t t_ns = sec * 1000000000LL + std::strtoll(frac.c_str(), nullptr, 10);
+
+            const size_t hash = frame.find('#');
+            if (hash == std::string::npos || hash == 0) continue;
+            const uint32_t id = static_cast<uint32_t>(std::strtoul(frame.substr(0, hash).c_str(), nullptr, 16));
+            if (id & 0x20000000u) continue;  // CAN_ERR_FLAG
+            size_t p = hash + 1;
+            uint8_t flags = dir == "T" ? kReplayTx : 0;
+            if (hash > 3) flags |= kReplayEff;  // candump 以 8 位十六进制 ID 表示扩展帧
+            if (p < frame.size() && frame[p] == '#') {
+                flags |= kReplayFd;
+                p += 2;  // "##" 后一位十六进制为 FD 标志
+            } else if (p < frame.size() && (frame[p] == 'R' || frame[p] == 'r')) {
+                continue;
+            }
+            buf.clear();
+            bool ok = true;
+            int hi = -1;
+            for (; p < frame.size(); ++p) {
+                if (frame[p] == '.') continue;  // 部分版本 candump 以 '.' 分隔字节
+                const int v = hexDigit(frame[p]);
+                if (v < 0) {
+                    ok = false;
+                    break;
+                }
+                if (hi < 0) {
+                    hi = v;
+                } else {
+                    buf.push_back(static_cast<uint8_t>((hi << 4) | v));
+                    hi = -1;
+                }
+            }
+            ok = ok && hi < 0;
+            if (!ok || buf.size() > 64) continue;
+            log.add(t_ns, id & 0x1FFFFFFFu, buf.data(), buf.size(), flags);
+        }
+        return log;
+    }
+
+    static ReplayLog fromCandump(const std::string& path)
+    {
+        std::ifstream in(path);
+        if (!in) throw InvalidParameterException("candump log: cannot open " + path);
+        return fromCandump(static_cast<std::istream&>(in));
+    }
+
+private:
+    // 会话记录头的帧标志 → 回放标志
+    static uint8_t canFlags(const SessionRecord& r)
+    {
+        uint8_t flags = (r.flags & kSessionFrameFd) ? kReplayFd : 0;
+        if (r.flags & kSessionFrameEff) flags |= kReplayEff;
+        return flags;
+    }
+
+    static int hexDigit(char c)
+    {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    std::vector<ReplayFrame> frames_;
+    std::vector<uint8_t> bytes_;
+};
+
+enum class ReplayPace {
+    RealTime,          // 按录制时间间隔投递
+    Scaled,            // 按 speed 倍速投递
+    AsFastAsPossible,  // 不等待；可作解码吞吐基准
+};
+
+struct ReplayConfig {
+    ReplayPace pace       = ReplayPace::RealTime;
+    double     speed      = 1.0;    // 仅 Scaled 使用
+    bool       loop       = false;  // 到末尾后从头继续，虚拟时钟顺延
+    bool       include_tx = false;  // 连录制时主机发出的帧一并投递
+};
+
+struct ReplayStats {
+    uint64_t delivered = 0;   // 已投递给 RX 的帧数
+    uint64_t skipped   = 0;   // 本传输无法承载而跳过的帧（如经典 CAN 上的 FD 帧）
+    uint64_t sent      = 0;   // 回放期间 SDK 发出的帧数
+    uint64_t loops     = 0;
+    bool     finished  = false;
+    double   wall_seconds      = 0.0;  // 首帧投递到最后一帧投递的实际用时
+    double   frames_per_second = 0.0;
+};
+
+// 回放引擎：按节奏从 ReplayLog 中取下一帧，并维护虚拟时钟。
+// 虚拟时钟以录制时间为准：实时 / 倍速模式下随墙钟按倍率推进；尽快模式下只随投递推进，
+// 因此同一日志的每次回放、各帧投递时刻看到的虚拟时间完全一致。
+class ReplayEngine
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    ReplayEngine(std::shared_ptr<const ReplayLog> log, const ReplayConfig& config, uint8_t kind_mask, uint8_t kind)
+        : log_(std::move(log)), config_(config), kind_mask_(kind_mask), kind_(kind)
+    {
+        if (!log_) throw InvalidParameterException("ReplayEngine: null log");
+        if (config_.pace == ReplayPace::Scaled && !(config_.speed > 0.0)) {
+            throw InvalidParameterException("ReplayEngine: speed must be positive");
+        }
+        if (config_.pace == ReplayPace::RealTime) config_.speed = 1.0;
+        if (!config_.include_tx) kind_mask_ |= kReplayTx;
+        virtual_ns_ = log_->empty() ? 0 : (*log_)[0].t_ns;
+    }
+
+    // 取下一帧。实时 / 倍速模式下等到其投递时刻；最多等待 timeout（负值表示一直等到可投递或 stop()）。
+    // 回放结束、超时或已停止返回 false。
+    template <typename Accept>
+    bool next(std::chrono::milliseconds timeout, Accept&& accept)
+    {
+        std::unique_lock<std::mutex> lk(mutex_);
+        const auto give_up = timeout.count() < 0 ? Clock::time_point::max() : Clock::now() + timeout;
+        while (!stopped_) {
+            if (!started_) {
+                started_ = true;
+                start_wall_ = Clock::now();
+                base_ns_ = virtual_ns_;
+            }
+            const ReplayFrame* f = peekLocked();
+            if (f == nullptr) {
+                finished_ = true;
+                cv_.notify_all();
+                cv_.wait_until(lk, give_up, [this] { return stopped_; });
+                return false;
+            }
+            if (config_.pace != ReplayPace::AsFastAsPossible) {
+                const auto due = start_wall_ + std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double, std::nano>(static_cast<double>(f->t_ns + offset_ns_ - base_ns_) / config_.speed));
+                if (Clock::now() < due) {
+                    if (due > give_up) {
+                        cv_.wait_until(lk, give_up, [this] { return stopped_; });
+                        return false;
+                    }
+                    cv_.wait_until(lk, due, [this] { return stopped_; });
+                    continue;
+                }
+            }
+            ++index_;
+            virtual_ns_ = f->t_ns + offset_ns_;
+            if (!accept(*f, log_->data(*f))) {
+                ++stats_.skipped;
+                continue;
+            }
+            const auto now = Clock::now();
+            if (stats_.delivered++ == 0) first_wall_ = now;
+            last_wall_ = now;
+            return true;
+        }
+        return false;
+    }
+
+    void countSent()
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        ++stats_.sent;
+    }
+
+    // 当前虚拟时刻（录制时间轴，纳秒）
+    int64_t now() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (!started_ || config_.pace == ReplayPace::AsFastAsPossible || finished_) return virtual_ns_;
+        const double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start_wall_).count();
+        return std::max(virtual_ns_, base_ns_ + static_cast<int64_t>(elapsed * config_.speed));
+    }
+
+    // 解除阻塞中的 next()，之后不再投递
+    void stop()
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        stopped_ = true;
+        cv_.notify_all();
+    }
+
+    // 从头开始（统计清零）
+    void restart()
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        index_ = 0;
+        offset_ns_ = 0;
+        started_ = finished_ = stopped_ = false;
+        stats_ = ReplayStats{};
+        virtual_ns_ = log_->empty() ? 0 : (*log_)[0].t_ns;
+        cv_.notify_all();
+    }
+
+    // 等待全部帧投递完毕（loop 模式下不会结束）
+    bool waitFinished(std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lk(mutex_);
+        return cv_.wait_for(lk, timeout, [this] { return finished_; });
+    }
+
+    ReplayStats stats() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        ReplayStats s = stats_;
+        s.finished = finished_;
+        if (s.delivered > 1) {
+            s.wall_seconds = std::chrono::duration<double>(last_wall_ - first_wall_).count();
+            if (s.wall_seconds > 0.0) s.frames_per_second = static_cast<double>(s.delivered - 1) / s.wall_seconds;
+        }
+        return s;
+    }
+
+    const ReplayLog& log() const { return *log_; }
+
+private:
+    // 下一帧属于本传输的帧；到末尾时按 loop 回绕
+    const ReplayFrame* peekLocked()
+    {
+        const ReplayLog& log = *log_;
+        for (int wrapped = 0; wrapped < 2; ++wrapped) {
+            while (index_ < log.size()) {
+                const ReplayFrame& f = log[index_];
+                if ((f.flags & kind_mask_) == kind_) return &f;
+                ++index_;
+            }
+            if (!config_.loop || log.empty()) return nullptr;
+            // 下一圈整体顺延一个日志时长（外加一帧间隔的余量），虚拟时钟保持单调
+            offset_ns_ += log.duration() + 1000000;
+            index_ = 0;
+            ++stats_.loops;
+        }
+        return nullptr;
+    }
+
+    std::shared_ptr<const ReplayLog> log_;
+    ReplayConfig config_;
+    uint8_t kind_mask_;
+    uint8_t kind_;
+
+    mutable std::mutex      mutex_;
+    std::condition_variable cv_;
+    size_t  index_     = 0;
+    int64_t offset_ns_ = 0;   // loop 累计顺延
+    int64_t base_ns_   = 0;   // 开始回放时的虚拟时刻
+    int64_t virtual_ns_ = 0;
+    bool    started_  = false;
+    bool    finished_ = false;
+    bool    stopped_  = false;
+    Clock::time_point start_wall_{};
+    Clock::time_point first_wall_{};
+    Clock::time_point last_wall_{};
+    ReplayStats stats_;
+};
+
+// SDK 发出的帧（can_id / 从站地址, 数据, 长度），用于核对回放期间 SDK 的输出
+using ReplayTxObserver = std::function<void(uint32_t id, const uint8_t* data, size_t len)>;
+
+// 经典 CAN 回放：recv() 按节奏返回日志中的接收帧，send() 只计数并交给观察者。
+// 无帧可投递时 recv() 最多等待 10ms 后返回空帧（can_id 与 can_dlc 为 0，与 CanBus 一致）。
+class ReplayCanBus : public communication::ICanBus
+{
+public:
+    explicit ReplayCanBus(std::shared_ptr<const ReplayLog> log, const ReplayConfig& config = ReplayConfig())
+        : engine_(std::move(log), config, kReplayModbus, 0) {}
+
+    ~ReplayCanBus() override { engine_.stop(); }
+
+    void send(const std::vector<uint8_t>& data, uint32_t can_id, const bool wait = false) override
+    {
+        (void)wait;
+        engine_.countSent();
+        if (tx_observer_) tx_observer_(can_id, data.data(), data.size());
+    }
+
+    CANFrame recv() override
+    {
+        CANFrame out{};
+        engine_.next(std::chrono::milliseconds(10), [&out](const ReplayFrame& f, const uint8_t* data) {
+            if (f.len > 8) return false;
+            out.can_id  = f.id;
+            out.can_dlc = static_cast<uint8_t>(f.len);
+            std::memcpy(out.data, data, f.len);
+            return true;
+        });
+        return out;
+    }
+
+    // 直接作为 LinkerHandApi 的回调使用，省去示例里的转接 lambda
+    CanTxCallback txCallback()
+    {
+        return [this](uint32_t can_id, const uint8_t* data, uintptr_t len) -> int32_t {
+            engine_.countSent();
+            if (tx_observer_) tx_observer_(can_id, data, static_cast<size_t>(len));
+            return 0;
+        };
+    }
+
+    CanRxCallback rxCallback()
+    {
+        return [this](uint32_t* can_id, uint8_t* data, uint8_t* len) -> int32_t {
+            const CANFrame f = recv();
+            if (f.can_id == 0 && f.can_dlc == 0) return -1;
+            *can_id = f.can_id;
+            *len = f.can_dlc;
+            std::memcpy(data, f.data, f.can_dlc);
+            return 0;
+        };
+    }
+
+    // 在接入 LinkerHandApi 之前设置
+    void setTxObserver(ReplayTxObserver observer) { tx_observer_ = std::move(observer); }
+
+    ReplayEngine& engine() { return engine_; }
+    int64_t now() const { return engine_.now(); }
+    ReplayStats stats() const { return engine_.stats(); }
+
+private:
+    ReplayEngine engine_;
+    ReplayTxObserver tx_observer_;
+};
+
+// CAN FD 回放（O20）：经典帧与 FD 帧均投递
+class ReplayCanFD : public communication::ICanFD
+{
+public:
+    explicit ReplayCanFD(std::shared_ptr<const ReplayLog> log, const ReplayConfig& config = ReplayConfig())
+        : engine_(std::move(log), config, kReplayModbus, 0) {}
+
+    ~ReplayCanFD() override { engine_.stop(); }
+
+    void send(const std::vector<uint8_t>& data, uint32_t can_id, bool is_extended = true) override
+    {
+        (void)is_extended;
+        engine_.countSent();
+        if (tx_observer_) tx_observer_(can_id, data.data(), data.size());
+    }
+
+    communication::CanFDFrame recv(int timeout_ms = 100) override
+    {
+        communication::CanFDFrame out{};
+        out.valid = engine_.next(std::chrono::milliseconds(timeout_ms), [&out](const ReplayFrame& f, const uint8_t* data) {
+            if (f.len > 64) return false;
+            out.can_id      = f.id;
+            out.can_dlc     = lenToDlc(f.len);
+            out.frame_type  = (f.flags & kReplayFd) ? 1 : 0;
+            out.extern_flag = (f.flags & kReplayEff) ? 1 : 0;
+            std::memcpy(out.data, data, f.len);
+            return true;
+        });
+        return out;
+    }
+
+    bool isOpen() const override { return true; }
+
+    void setTxObserver(ReplayTxObserver observer) { tx_observer_ = std::move(observer); }
+
+    // CAN FD 长度 → DLC（非标准长度向上取到下一档）
+    static uint8_t lenToDlc(size_t len)
+    {
+        static const uint8_t sizes[] = {12, 16, 20, 24, 32, 48, 64};
+        if (len <= 8) return static_cast<uint8_t>(len);
+        for (uint8_t i = 0; i < 7; ++i) {
+            if (len <= sizes[i]) return static_cast<uint8_t>(9 + i);
+        }
+        return 15;
+    }
+
+    ReplayEngine& engine() { return engine_; }
+    int64_t now() const { return engine_.now(); }
+    ReplayStats stats() const { return engine_.stats(); }
+
+private:
+    ReplayEngine engine_;
+    ReplayTxObserver tx_observer_;
+};
+
+// Modbus RTU 回放：receiveCompleteFrame() / transact() 依次返回日志中的应答帧
+class ReplayModbus : public communication::IModbus
+{
+public:
+    explicit ReplayModbus(std::shared_ptr<const ReplayLog> log, const ReplayConfig& config = ReplayConfig())
+        : engine_(std::move(log), config, kReplayModbus, kReplayModbus) {}
+
+    ~ReplayModbus() override { engine_.stop(); }
+
+    bool isOpen() const override { return open_.load(); }
+
+    void close() override
+    {
+        open_ = false;
+        engine_.stop();
+    }
+
+    bool sendRawFrame(const uint8_t* data, size_t length) override
+    {
+        engine_.countSent();
+        if (tx_observer_) tx_observer_(length ? data[0] : 0, data, length);
+        return isOpen();
+    }
+
+    int receiveCompleteFrame(uint8_t* buffer, size_t max_size, int timeout_ms = 500) override
+    {
+        int n = -1;
+        engine_.next(std::chrono::milliseconds(timeout_ms), [&](const ReplayFrame& f, const uint8_t* data) {
+            if (f.len > max_size) return false;
+            std::memcpy(buffer, data, f.len);
+            n = static_cast<int>(f.len);
+            return true;
+        });
+        return n;
+    }
+
+    int transact(const uint8_t* request, size_t request_len, uint8_t* response, size_t max_response_len,
+                 int timeout_ms = 500) override
+    {
+        if (!sendRawFrame(request, request_len)) return -1;
+        return receiveCompleteFrame(response, max_response_len, timeout_ms);
+    }
+
+    void setTxObserver(ReplayTxObserver observer) { tx_observer_ = std::move(observer); }
+
+    ReplayEngine& engine() { return engine_; }
+    int64_t now() const { return engine_.now(); }
+    ReplayStats stats() const { return engine_.stats(); }
+
+private:
+    ReplayEngine engine_;
+    ReplayTxObserver tx_observer_;
+    std::atomic<bool> open_{true};
+};
+
+}  // namespace api
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_SESSION_REPLAY_H
@@ -0,0 +1,368 @@
+#ifndef LINKERHAND_STATE_HISTORY_H
+#define LINKERHAND_STATE_HISTORY_H
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include "HandState.h"
+#include "StateSubscription.h"
+#include "core/ErrorCode.h"
+
+namespace linkerhand {
+namespace api {
+
+// 各类样本的元素数与取值，供窗口统计按元素遍历（关节 / 手指 / 触觉单元）
+inline size_t sampleWidth(const JointSample& s) { return s.count; }
+inline size_t sampleWidth(const FingerSample& s) { return s.count; }
+inline size_t sampleWidth(const FingerTactileSample& s) { return static_cast<size_t>(s.fingers) * s.rows * s.cols; }
+inline size_t sampleWidth(const PalmTactileSample& s) { return static_cast<size_t>(s.rows) * s.cols; }
+inline uint8_t sampleAt(const JointSample& s, size_t i) { return s.values[i]; }
+inline uint8_t sampleAt(const FingerSample& s, size_t i) { return s.values[i]; }
+inline uint8_t sampleAt(const FingerTactileSample& s, size_t i) { return s.cells[i]; }
+inline uint8_t sampleAt(const PalmTactileSample& s, size_t i) { return s.cells[i]; }
+
+// 单个元素在一段窗口内的统计。slope 为最小二乘斜率（每秒变化量），可直接当速度估计用。
+struct WindowStats {
+    uint32_t count  = 0;
+    double   mean   = 0.0;
+    double   stddev = 0.0;
+    double   slope  = 0.0;
+    uint8_t  min    = 0;
+    uint8_t  max    = 0;
+    uint8_t  first  = 0;
+    uint8_t  last   = 0;
+};
+
+template <typename T>
+class TimeSeriesRing;
+
+// 环形历史的一段视图：不拷贝数据，下标 0 为最旧。
+// 写端只在覆盖时才会破坏视图；用完后调用 valid() 确认期间没有被覆盖，失效时重新查询。
+template <typename T>
+class HistoryView
+{
+public:
+    using Entry = typename TimeSeriesRing<T>::Entry;
+
+    HistoryView() = default;
+    HistoryView(const TimeSeriesRing<T>* ring, uint64_t first, size_t count)
+        : ring_(ring), first_(first), count_(count) {}
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    // 首个样本的写入序号（从 0 起），可用于判断两次查询之间新增了多少样本
+    uint64_t firstIndex() const { return first_; }
+
+    const Entry& operator[](size_t i) const { return ring_->slot(first_ + i); }
+    const Entry& front() const { return (*this)[0]; }
+    const Entry& back() const { return (*this)[count_ - 1]; }
+
+    // 视图内的样本至今未被覆盖
+    bool valid() const { return ring_ == nullptr || ring_->intact(first_); }
+
+    // 拷进调用方缓冲区（至少 size() 个）；期间被覆盖返回 false
+    bool copyTo(Entry* out) const
+    {
+        for (size_t i = 0; i < count_; ++i) std::memcpy(static_cast<void*>(out + i), &(*this)[i], sizeof(Entry));
+        return valid();
+    }
+
+    // 对前 n 个元素分别做窗口统计，结果写入 out[0..n)；不分配内存。期间被覆盖返回 false。
+    bool stats(WindowStats* out, size_t n) const
+    {
+        // 先用 out 的字段暂存累加量：mean ← Σv，stddev ← Σv²，slope ← Σtv
+        for (size_t e = 0; e < n; ++e) out[e] = WindowStats{};
+        if (count_ == 0) return valid();
+        const int64_t t0 = front().t_ns;
+        double sum_t = 0.0;
+        double sum_tt = 0.0;
+        uint32_t rows = 0;
+        for (size_t i = 0; i < count_; ++i) {
+            const Entry& en = (*this)[i];
+            const double t = static_cast<double>(en.t_ns - t0) * 1e-9;
+            const size_t width = sampleWidth(en.value) < n ? sampleWidth(en.value) : n;
+            sum_t += t;
+            sum_tt += t * t;
+            ++rows;
+            for (size_t e = 0; e < width; ++e) {
+                const uint8_t v = sampleAt(en.value, e);
+                WindowStats& s = out[e];
+                if (s.count == 0) {
+                    s.min = s.max = s.first = v;
+                } else {
+                    s.min = v < s.min ? v : s.min;
+                    s.max = v > s.max ? v : s.max;
+                }
+                s.last = v;
+                ++s.count;
+                s.mean   += v;
+                s.stddev += static_cast<double>(v) * v;
+                s.slope  += t * v;
+            }
+        }
+        if (!valid()) return false;
+        // 元素数在窗口内变化（换型号 / 形状变化）时，斜率按全部行的时间计，只作参考
+        const double nt = static_cast<double>(rows);
+        const double var_t = sum_tt - sum_t * sum_t / nt;
+        for (size_t e = 0; e < n; ++e) {
+            WindowStats& s = out[e];
+            if (s.count == 0) continue;
+            const double c = s.count;
+            const double sum_v = s.mean;
+            const double var = s.stddev / c - (sum_v / c) * (sum_v / c);
+            s.mean   = sum_v / c;
+            s.stddev = var > 0.0 ? std::sqrt(var) : 0.0;
+            s.slope  = (s.count == rows && var_t > 0.0) ? (s.slope - sum_t * sum_v / nt) / var_t : 0.0;
+        }
+        return true;
+    }
+
+private:
+    const TimeSeriesRing<T>* ring_ = nullptr;
+    uint64_t first_ = 0;
+    size_t   count_ = 0;
+};
+
+// 定容无锁时间序列环：单写多读，写端从不阻塞也不分配，读端拿视图直接访问环内存储。
+// 容量向上取 2 的幂。写端先登记将要覆盖的序号再写槽位，读端据此判断视图是否被覆盖（同 Seqlock 的思路），
+// 因此读到的内容要么完整有效，要么 valid() 报告失效。
+template <typename T>
+class TimeSeriesRing
+{
+    static_assert(std::is_trivially_copyable<T>::value, "TimeSeriesRing<T>: T must be trivially copyable");
+
+public:
+    struct Entry {
+        int64_t t_ns = 0;  // 样本时刻，steady_clock 纳秒，须单调不减
+        T       value;
+    };
+
+    explicit TimeSeriesRing(size_t capacity)
+    {
+        if (capacity < 2) {
+            throw InvalidParameterException("TimeSeriesRing: capacity must be at least 2");
+        }
+        size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        mask_ = cap - 1;
+        slots_.reset(new Entry[cap]);
+        std::memset(static_cast<void*>(slots_.get()), 0, cap * sizeof(Entry));
+    }
+
+    TimeSeriesRing(const TimeSeriesRing&) = delete;
+    TimeSeriesRing& operator=(const TimeSeriesRing&) = delete;
+
+    size_t capacity() const { return mask_ + 1; }
+
+    // 累计写入的样本数
+    uint64_t written() const { return head_.load(std::memory_order_acquire); }
+
+    // 追加一个样本（仅写线程调用）
+    void push(int64_t t_ns, const T& value) noexcept
+    {
+        const uint64_t h = head_.load(std::memory_order_relaxed);
+        claim_.store(h + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        Entry& e = slots_[h & mask_];
+        e.t_ns = t_ns;
+        std::memcpy(static_cast<void*>(&e.value), &value, sizeof(T));
+        head_.store(h + 1, std::memory_order_release);
+    }
+
+    // 最近 n 个样本（不足则全部）
+    HistoryView<T> latest(size_t n) const
+    {
+        const uint64_t h = written();
+        const uint64_t lo = oldest(h);
+        const uint64_t count = (h - lo) < n ? (h - lo) : n;
+        return HistoryView<T>(this, h - count, static_cast<size_t>(count));
+    }
+
+    // 时刻不早于 t_ns 的全部样本；按时间戳二分查找，检索期间被覆盖会自动重试
+    HistoryView<T> since(int64_t t_ns) const
+    {
+        while (true) {
+            const uint64_t h = written();
+            uint64_t lo = oldest(h);
+            uint64_t hi = h;
+            while (lo < hi) {
+                const uint64_t mid = lo + (hi - lo) / 2;
+                if (slot(mid).t_ns < t_ns) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            if (intact(oldest(h))) return HistoryView<T>(this, lo, static_cast<size_t>(h - lo));
+        }
+    }
+
+    // 最近一段时长内的样本（以最新样本时刻为终点）
+    HistoryView<T> window(std::chrono::nanoseconds span) const
+    {
+        const auto last = latest(1);
+        if (last.empty()) return last;
+        return since(last.back().t_ns - span.count());
+    }
+
+private:
+    friend class HistoryView<T>;
+
+    const Entry& slot(uint64_t index) const { return slots_[index & mask_]; }
+
+    // 可读的最旧序号：留出正在被覆盖的那一格
+    uint64_t oldest(uint64_t head) const { return head > mask_ ? head - mask_ : 0; }
+
+    // 序号 index 之后的样本尚未被覆盖
+    bool intact(uint64_t index) const
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return claim_.load(std::memory_order_relaxed) <= index + mask_ + 1;
+    }
+
+    size_t mask_ = 0;
+    std::unique_ptr<Entry[]> slots_;
+    std::atomic<uint64_t> head_{0};   // 已完成写入的样本数
+    std::atomic<uint64_t> claim_{0};  // 已开始写入的样本数（= head_ 或 head_ + 1）
+};
+
+// 整手状态历史：每个回读通道一个时间序列环，时间戳取 HandState 中该通道的 recv_ns。
+// 经 attach() 订阅 PollScheduler 的状态推送，由调度线程单线程写入；任意多个线程可同时查询，
+// 互不加锁，也不会触发总线读取。容量在构造时确定，之后不再分配。
+class StateHistory
+{
+public:
+    using JointRing  = TimeSeriesRing<JointSample>;
+    using FingerRing = TimeSeriesRing<FingerSample>;
+    using ForceRing  = TimeSeriesRing<FingerTactileSample>;
+    using PalmRing   = TimeSeriesRing<PalmTactileSample>;
+
+    // capacity：关节与单指标量通道的样本数；tactile_capacity：触觉矩阵通道（单样本约 0.7KB）
+    explicit StateHistory(size_t capacity = 1024, size_t tactile_capacity = 128)
+    {
+        for (auto ch : {PollChannel::Position, PollChannel::Speed, PollChannel::Torque,
+                        PollChannel::Temperature, PollChannel::FaultCode}) {
+            joints_[jointIndex(ch)].reset(new JointRing(capacity));
+        }
+        for (size_t k = 0; k < kFingerChannels; ++k) fingers_[k].reset(new FingerRing(capacity));
+        force_.reset(new ForceRing(tactile_capacity));
+        palm_.reset(new PalmRing(tactile_capacity));
+    }
+
+    ~StateHistory() { detach(); }
+
+    StateHistory(const StateHistory&) = delete;
+    StateHistory& operator=(const StateHistory&) = delete;
+
+    // 订阅调度器推送；同一时刻只能挂一个 hub。调度器运行中析构前请先 detach() 或 stop()。
+    void attach(StateSubscriptionHub& hub, uint32_t channel_mask = kAllChannels)
+    {
+        detach();
+        hub_ = &hub;
+        sub_ = hub.subscribe(channel_mask, [this](PollChannel ch, const HandState& st) { record(ch, st); });
+    }
+
+    void detach()
+    {
+        if (hub_ == nullptr) return;
+        hub_->unsubscribe(sub_);
+        hub_ = nullptr;
+    }
+
+    // 记录快照中某通道的当前样本；同一回读序号只记一次（单写线程调用）
+    void record(PollChannel ch, const HandState& st)
+    {
+        if (ch >= PollChannel::Count) return;
+        const ChannelStamp& stamp = st.stamp(ch);
+        uint64_t& last = last_seq_[static_cast<size_t>(ch)];
+        if (stamp.sequence == 0 || stamp.sequence == last) return;
+        last = stamp.sequence;
+        const int64_t t = stamp.recv_ns;
+        switch (ch) {
+            case PollChannel::Position:        joints_[0]->push(t, st.position);    break;
+            case PollChannel::Speed:           joints_[1]->push(t, st.speed);       break;
+            case PollChannel::Torque:          joints_[2]->push(t, st.torque);      break;
+            case PollChannel::Temperature:     joints_[3]->push(t, st.temperature); break;
+            case PollChannel::FaultCode:       joints_[4]->push(t, st.fault);       break;
+            case PollChannel::Force:           force_->push(t, st.force);           break;
+            case PollChannel::PalmForce:       palm_->push(t, st.palm);             break;
+            case PollChannel::NormalForce:     fingers_[0]->push(t, st.normal);     break;
+            case PollChannel::TangentialForce: fingers_[1]->push(t, st.tangential); break;
+            case PollChannel::TangentialDir:   fingers_[2]->push(t, st.direction);  break;
+            case PollChannel::Proximity:       fingers_[3]->push(t, st.proximity);  break;
+            default:
+                break;
+        }
+    }
+
+    // 位置 / 速度 / 力矩 / 温度 / 故障码
+    const JointRing& joints(PollChannel ch) const { return *joints_[jointIndex(ch)]; }
+    // 法向 / 切向 / 方向 / 接近
+    const FingerRing& fingers(PollChannel ch) const
+    {
+        const size_t k = static_cast<size_t>(ch) - static_cast<size_t>(PollChannel::NormalForce);
+        if (ch < PollChannel::NormalForce || k >= kFingerChannels) {
+            throw InvalidParameterException("StateHistory::fingers: not a per-finger channel");
+        }
+        return *fingers_[k];
+    }
+    const ForceRing& force() const { return *force_; }
+    const PalmRing& palm() const { return *palm_; }
+
+    // 最近 span 时长内各元素的窗口统计，out 至少 n 个；期间被覆盖自动重新查询。返回窗口内样本数。
+    size_t windowStats(PollChannel ch, std::chrono::nanoseconds span, WindowStats* out, size_t n) const
+    {
+        switch (ch) {
+            case PollChannel::Force:     return statsOf(*force_, span, out, n);
+            case PollChannel::PalmForce: return statsOf(*palm_, span, out, n);
+            case PollChannel::NormalForce:
+            case PollChannel::TangentialForce:
+            case PollChannel::TangentialDir:
+            case PollChannel::Proximity:
+                return statsOf(fingers(ch), span, out, n);
+            default:
+                return statsOf(joints(ch), span, out, n);
+        }
+    }
+
+private:
+    static constexpr size_t kJointChannels  = 5;  // Position .. FaultCode
+    static constexpr size_t kFingerChannels = 4;  // NormalForce .. Proximity
+
+    static size_t jointIndex(PollChannel ch)
+    {
+        const size_t i = static_cast<size_t>(ch);
+        if (i >= kJointChannels) {
+            throw InvalidParameterException("StateHistory::joints: not a joint channel");
+        }
+        return i;
+    }
+
+    template <typename T>
+    static size_t statsOf(const TimeSeriesRing<T>& ring, std::chrono::nanoseconds span, WindowStats* out, size_t n)
+    {
+        while (true) {
+            const auto view = ring.window(span);
+            if (view.stats(out, n)) return view.size();
+        }
+    }
+
+    std::unique_ptr<JointRing>  joints_[kJointChannels];
+    std::unique_ptr<FingerRing> fingers_[kFingerChannels];
+    std::unique_ptr<ForceRing>  force_;
+    std::unique_ptr<PalmRing>   palm_;
+    uint64_t last_seq_[kPollChannelCount] = {};  // 仅写线程访问
+
+    StateSubscriptionHub* hub_ = nullptr;
+    SubscriptionId sub_ = 0;
+};
+
+}  // namespace api
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_STATE_HISTORY_H
@@ -0,0 +1,233 @@
+#ifndef LINKERHAND_STATE_SUBSCRIPTION_H
+#define LINKERHAND_STATE_SUBSCRIPTION_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include "HandState.h"
+
+namespace linkerhand {
+namespace api {
+
+inline constexpr uint32_t channelBit(PollChannel ch) { return 1u << static_cast<uint32_t>(ch); }
+constexpr uint32_t kAllChannels = (1u << kPollChannelCount) - 1u;
+
+// 条件变量式订阅端：消费线程 wait()，有新样本即返回；多次通知只累计一次唤醒，
+// 天然只取最新值。
+class StateWaiter
+{
+public:
+    // 等到有未消费的通知或超时；返回期间累计的通道位（超时为 0）
+    template <typename Rep, typename Period>
+    uint32_t waitFor(const std::chrono::duration<Rep, Period>& timeout)
+    {
+        std::unique_lock<std::mutex> lk(mutex_);
+        cv_.wait_for(lk, timeout, [this] { return pending_ != 0; });
+        const uint32_t bits = pending_;
+        pending_ = 0;
+        return bits;
+    }
+
+    void notify(uint32_t bits)
+    {
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            pending_ |= bits;
+        }
+        cv_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    uint32_t pending_ = 0;
+};
+
+using SubscriptionId = uint64_t;
+// 回调在调度线程内同步执行，须尽快返回；耗时处理请改用 StateWaiter / eventfd。
+using StateCallback = std::function<void(PollChannel, const HandState&)>;
+
+// 状态订阅表。发布端（调度线程）每解出一个新样本调用 notify()；
+// 每个订阅者有自己的通道掩码与最小间隔，间隔按通道分别计算，间隔内同一通道的中间样本直接跳过。
+class StateSubscriptionHub
+{
+public:
+    SubscriptionId subscribe(uint32_t channel_mask, StateCallback callback,
+                             std::chrono::nanoseconds min_interval = std::chrono::nanoseconds(0))
+    {
+        auto sub = makeSub(channel_mask, min_interval);
+        sub->callback = std::move(callback);
+        return add(std::move(sub));
+    }
+
+    // 通知到 StateWaiter；waiter 生命周期须覆盖订阅期
+    SubscriptionId subscribe(uint32_t channel_mask, StateWaiter& waiter,
+                             std::chrono::nanoseconds min_interval = std::chrono::nanoseconds(0))
+    {
+        auto sub = makeSub(channel_mask, min_interval);
+        sub->waiter = &waiter;
+        return add(std::move(sub));
+    }
+
+#ifdef __linux__
+    // 每次通知向 eventfd 写 1，便于接入 epoll / io_uring；fd 由调用方创建与关闭
+    SubscriptionId subscribeEventFd(uint32_t channel_mask, int event_fd,
+                                    std::chrono::nanoseconds min_interval = std::chrono::nanoseconds(0))
+    {
+        auto sub = makeSub(channel_mask, min_interval);
+        sub->event_fd = event_fd;
+        return add(std::move(sub));
+    }
+#endif
+
+    // 返回后该订阅不再被调用：等待已拿到旧快照、正在投递给它的 notify() 结束，
+    // 之后即可安全销毁回调捕获的对象、waiter 或关闭 eventfd。
+    // 在该订阅自己的回调里取消时不等待本线程的这次投递（回调返回前捕获的对象仍须有效）。
+    void unsubscribe(SubscriptionId id)
+    {
+        std::shared_ptr<Sub> removed;
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            auto next = std::make_shared<SubList>();
+            for (const auto& s : *subs_) {
+                if (s->id != id) next->push_back(s);
+                else removed = s;
+            }
+            subs_ = std::move(next);
+        }
+        if (!removed) return;
+        removed->active.store(false);
+        const int self = dispatching() == removed.get() ? 1 : 0;
+        while (removed->busy.load() > self) std::this_thread::yield();
+    }
+
+    bool empty() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return subs_->empty();
+    }
+
+    void notify(PollChannel ch, const HandState& state)
+    {
+        std::shared_ptr<const SubList> subs;
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            subs = subs_;
+        }
+        const uint32_t bit = channelBit(ch);
+        const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        const size_t idx = static_cast<size_t>(ch);
+        for (const auto& s : *subs) {
+            if (!(s->mask & bit)) continue;
+            const int64_t last = s->last_ns[idx].load(std::memory_order_relaxed);
+            if (s->min_interval_ns > 0 && last != 0 && now - last < s->min_interval_ns) {
+                s->skipped.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            // 先登记在途再检查 active，与 unsubscribe 的“先置 active 再等 busy”配对
+            s->busy.fetch_add(1);
+            if (!s->active.load()) {
+                s->busy.fetch_sub(1);
+                continue;
+            }
+            InFlight guard(s.get());
+            s->last_ns[idx].store(now, std::memory_order_relaxed);
+            if (s->callback) {
+                s->callback(ch, state);
+            } else if (s->waiter) {
+                s->waiter->notify(bit);
+            }
+#ifdef __linux__
+            else if (s->event_fd >= 0) {
+                const uint64_t one = 1;
+                ssize_t n = ::write(s->event_fd, &one, sizeof(one));
+                (void)n;
+            }
+#endif
+        }
+    }
+
+    // 某订阅因节流而跳过的样本数
+    uint64_t skipped(SubscriptionId id) const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        for (const auto& s : *subs_) {
+            if (s->id == id) return s->skipped.load(std::memory_order_relaxed);
+        }
+        return 0;
+    }
+
+private:
+    struct Sub {
+        SubscriptionId        id = 0;
+        uint32_t              mask = 0;
+        int64_t               min_interval_ns = 0;
+        std::atomic<int64_t>  last_ns[kPollChannelCount] = {};   // 各通道上次投递时刻
+        std::atomic<uint64_t> skipped{0};
+        std::atomic<bool>     active{true};
+        std::atomic<int>      busy{0};                             // 正在投递的 notify() 数
+        StateCallback         callback;
+        StateWaiter*          waiter = nullptr;
+        int                   event_fd = -1;
+    };
+    using SubList = std::vector<std::shared_ptr<Sub>>;
+
+    static std::shared_ptr<Sub> makeSub(uint32_t mask, std::chrono::nanoseconds min_interval)
+    {
+        auto sub = std::make_shared<Sub>();
+        sub->mask = mask;
+        sub->min_interval_ns = min_interval.count();
+        return sub;
+    }
+
+    // 本线程正在投递的订阅（回调内 unsubscribe 自身时不等待自己）
+    static Sub*& dispatching()
+    {
+        thread_local Sub* current = nullptr;
+        return current;
+    }
+
+    // 一次投递的在途登记：回调抛异常时也会撤销
+    struct InFlight {
+        Sub* sub;
+        Sub* outer;
+        explicit InFlight(Sub* s) : sub(s), outer(dispatching()) { dispatching() = s; }
+        ~InFlight()
+        {
+            dispatching() = outer;
+            sub->busy.fetch_sub(1);
+        }
+    };
+
+    SubscriptionId add(std::shared_ptr<Sub> sub)
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        sub->id = ++next_id_;
+        auto next = std::make_shared<SubList>(*subs_);
+        next->push_back(std::move(sub));
+        subs_ = std::move(next);
+        return next_id_;
+    }
+
+    mutable std::mutex mutex_;
+    // 写时复制：notify 拿快照后无锁遍历，回调里可安全地 subscribe / unsubscribe
+    std::shared_ptr<const SubList> subs_ = std::make_shared<SubList>();
+    SubscriptionId next_id_ = 0;
+};
+
+}  // namespace api
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_STATE_SUBSCRIPTION_H
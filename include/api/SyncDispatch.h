@@ -0,0 +1,406 @@
+#ifndef LINKERHAND_SYNC_DISPATCH_H
+#define LINKERHAND_SYNC_DISPATCH_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "CommunicationCallbacks.h"
+#include "core/ErrorCode.h"
+#include "core/ThreadConfig.h"
+
+namespace linkerhand {
+namespace api {
+
+struct SyncDispatchConfig {
+    // 某只手最后一帧截获后静默多久，视为该手的指令帧已全部到齐（SDK 对多帧指令有帧间延时）；
+    // 未给出帧数的指令执行完后静默这么久仍无帧，视为不产生帧
+    std::chrono::microseconds settle{8000};
+    // 暂存后最长等待；超时仍放行已截获的帧，报告 complete = false
+    std::chrono::milliseconds stage_timeout{100};
+    // 放行时刻距唤醒各通道线程的提前量，用于把不同适配器的首帧对齐到同一时刻
+    std::chrono::microseconds release_lead{300};
+    // 通道线程的调度配置（名字后加通道号）。通道线程自旋到放行时刻，宜用 SCHED_FIFO 并各占一核
+    ThreadConfig lane_thread;
+};
+
+// 单只手在一次放行中的实测发送时刻（steady_clock 纳秒）
+struct SyncHandTiming {
+    size_t  hand = 0;
+    size_t  frames = 0;
+    int64_t first_ns = 0;   // 首帧写入开始
+    int64_t last_ns = 0;    // 末帧写入返回
+    size_t  errors = 0;     // 发送函数返回非 0 的帧数
+};
+
+struct SyncDispatchReport {
+    bool    complete = true;  // 所有手均在 stage_timeout 内凑齐指令帧
+    size_t  frames = 0;
+    int64_t release_ns = 0;   // 计划放行时刻
+    int64_t skew_ns = 0;      // 各手首帧写入时刻的最大差
+    int64_t span_ns = 0;      // 最早首帧到最晚末帧
+    std::vector<SyncHandTiming> hands;
+};
+
+struct SyncDispatchStats {
+    uint64_t dispatches = 0;
+    uint64_t incomplete = 0;
+    int64_t  max_skew_ns = 0;
+    double   mean_skew_ns = 0.0;
+};
+
+// 多手同步下发：先暂存各手的指令，截获它们产生的 CAN 帧，再在同一时刻一起放行。
+//
+// 用法：每只手用 addHand() 注册真实的发送函数，把 txCallback(i) 交给该手的
+// LinkerHandApi::setCanTxCallback（有回读调度器时也交给 PollScheduler::setRawTx）。
+// 平时包裹回调直通；stage(i, cmd) 执行 cmd 期间及之后，该手发出的帧都被截获，
+// release() 等各手的帧到齐（expected_frames 满足，或静默 settle）后统一放行并返回实测偏差。
+//
+// lane 表示发送通道：同一 lane 的手由同一线程按帧轮流交错发送（同一适配器 / 同一总线上本就串行），
+// 不同 lane（不同适配器）由各自的线程在同一时刻并行发送。lane 0 由调用 release() 的线程发送；
+// 单核机器上全部 lane 都由该线程交错发送。
+// 与回读调度器并发时，暂存期间截获的回读请求帧随批次一起放行。
+class SyncDispatcher
+{
+public:
+    explicit SyncDispatcher(const SyncDispatchConfig& config = SyncDispatchConfig()) : config_(config) {}
+
+    ~SyncDispatcher()
+    {
+        {
+            std::lock_guard<std::mutex> lk(lane_mutex_);
+            stopping_ = true;
+        }
+        lane_cv_.notify_all();
+        for (auto& l : lanes_) {
+            if (l->thread.joinable()) l->thread.join();
+        }
+    }
+
+    SyncDispatcher(const SyncDispatcher&) = delete;
+    SyncDispatcher& operator=(const SyncDispatcher&) = delete;
+
+    // 注册一只手，返回其编号。请在 release() 之外的时间调用（通常在初始化阶段）。
+    size_t addHand(CanTxCallback tx, unsigned lane = 0)
+    {
+        if (!tx) throw InvalidParameterException("SyncDispatcher::addHand: null tx callback");
+        std::lock_guard<std::mutex> lk(dispatch_mutex_);
+        std::unique_ptr<Hand> h(new Hand);
+        h->tx = std::move(tx);
+        h->index = hands_.size();
+        Lane& l = laneLocked(lane);
+        l.hands.push_back(h.get());
+        hands_.push_back(std::move(h));
+        return hands_.size() - 1;
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lk(dispatch_mutex_);
+        return hands_.size();
+    }
+
+    // 交给 LinkerHandApi::setCanTxCallback 的包裹回调
+    CanTxCallback txCallback(size_t hand)
+    {
+        Hand* h = handAt(hand);
+        return [h](uint32_t can_id, const uint8_t* data, uintptr_t len) -> int32_t {
+            {
+                std::lock_guard<std::mutex> lk(h->mutex);
+                if (h->armed) {
+                    Frame f;
+                    f.id = can_id;
+                    f.len = static_cast<uint8_t>(std::min<uintptr_t>(len, sizeof(f.data)));
+                    std::memcpy(f.data, data, f.len);
+                    h->staged.push_back(f);
+                    h->last_capture = Clock::now();
+                    h->cv.notify_all();
+                    return 0;
+                }
+            }
+            return h->tx(can_id, data, len);
+        };
+    }
+
+    // 为 hand 暂存一条指令：开始截获该手的帧后执行 command（例如 [&] { api.setPosition(pose); }）。
+    // expected_frames 为该指令产生的帧数（已知时无需等待 settle）；0 表示按静默判断。
+    void stage(size_t hand, const std::function<void()>& command, size_t expected_frames = 0)
+    {
+        Hand* h = handAt(hand);
+        {
+            std::lock_guard<std::mutex> lk(h->mutex);
+            if (!h->armed) {
+                h->armed = true;
+                h->staged.clear();
+                h->expected = 0;
+                h->last_capture = Clock::now();
+            }
+            h->expected += expected_frames;
+            h->open_ended = h->open_ended || expected_frames == 0;
+        }
+        try {
+            if (command) command();
+        } catch (...) {
+            std::lock_guard<std::mutex> lk(h->mutex);
+            h->armed = false;
+            h->staged.clear();
+            throw;
+        }
+        // 尚无帧时静默从指令返回起算
+        std::lock_guard<std::mutex> lk(h->mutex);
+        if (h->staged.empty()) h->last_capture = Clock::now();
+    }
+
+    // 等待暂存的帧到齐后同时放行，返回各手实测的发送时刻与偏差
+    SyncDispatchReport release()
+    {
+        std::lock_guard<std::mutex> dlk(dispatch_mutex_);
+        SyncDispatchReport report;
+        const auto deadline = Clock::now() + config_.stage_timeout;
+
+        // 1. 等各手截获完整
+        std::vector<Hand*> armed;
+        for (auto& hp : hands_) {
+            Hand* h = hp.get();
+            std::unique_lock<std::mutex> lk(h->mutex);
+            if (!h->armed) continue;
+            armed.push_back(h);
+            for (;;) {
+                const auto now = Clock::now();
+                const bool counted = h->expected > 0 && h->staged.size() >= h->expected;
+                // 未截获任何帧时按指令返回后的静默判断，不产生帧的指令不必等满 stage_timeout
+                const bool quiet = now - h->last_capture >= config_.settle;
+                if (h->open_ended ? (counted || h->expected == 0) && quiet : counted) break;
+                if (now >= deadline) {
+                    report.complete = false;
+                    break;
+                }
+                const auto wake = h->open_ended
+                                      ? std::min(deadline, h->last_capture + config_.settle)
+                                      : deadline;  // 等计数：截获时会被唤醒
+                h->cv.wait_until(lk, std::max(wake, now + std::chrono::microseconds(50)));
+            }
+        }
+        if (armed.empty()) return report;
+
+        // 2. 持有全部已暂存手的锁放行：此间 SDK 迟到的帧阻塞在包裹回调中，放行后按序直通
+        std::vector<std::unique_lock<std::mutex>> locks;
+        locks.reserve(armed.size());
+        for (Hand* h : armed) locks.emplace_back(h->mutex);
+        for (Hand* h : armed) {
+            h->timing = SyncHandTiming();
+            h->timing.hand = h->index;
+            h->timing.frames = h->staged.size();
+        }
+
+        const int64_t release_ns = nowNs() + std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                 config_.release_lead).count();
+        // 单核上并行通道只能轮流运行，反而拉大偏差：改由本线程交错发送全部通道
+        const bool parallel = std::thread::hardware_concurrency() > 1;
+        std::vector<Hand*> local;
+        size_t busy_lanes = 0;
+        {
+            std::lock_guard<std::mutex> lk(lane_mutex_);
+            for (auto& l : lanes_) {
+                const bool active = std::any_of(l->hands.begin(), l->hands.end(), [](Hand* h) { return h->armed; });
+                l->active = active && parallel && l->id != 0;
+                if (l->active) {
+                    ++busy_lanes;
+                } else if (active) {
+                    local.insert(local.end(), l->hands.begin(), l->hands.end());
+                }
+            }
+            release_ns_ = release_ns;
+            lanes_done_ = 0;
+            ++generation_;
+        }
+        lane_cv_.notify_all();
+        sendFrames(local, release_ns);
+        {
+            std::unique_lock<std::mutex> lk(lane_mutex_);
+            lane_cv_.wait(lk, [&] { return lanes_done_ >= busy_lanes; });
+        }
+
+        // 3. 汇总
+        int64_t first_min = INT64_MAX, first_max = INT64_MIN, last_max = INT64_MIN;
+        for (Hand* h : armed) {
+            h->armed = false;
+            h->open_ended = false;
+            h->staged.clear();
+            report.frames += h->timing.frames;
+            report.hands.push_back(h->timing);
+            if (h->timing.frames == 0) continue;
+            first_min = std::min(first_min, h->timing.first_ns);
+            first_max = std::max(first_max, h->timing.first_ns);
+            last_max  = std::max(last_max, h->timing.last_ns);
+        }
+        locks.clear();
+        report.release_ns = release_ns;
+        if (first_min != INT64_MAX) {
+            report.skew_ns = first_max - first_min;
+            report.span_ns = last_max - first_min;
+        }
+
+        std::lock_guard<std::mutex> slk(stats_mutex_);
+        ++stats_.dispatches;
+        if (!report.complete) ++stats_.incomplete;
+        stats_.max_skew_ns = std::max(stats_.max_skew_ns, report.skew_ns);
+        stats_.mean_skew_ns += (static_cast<double>(report.skew_ns) - stats_.mean_skew_ns)
+                               / static_cast<double>(stats_.dispatches);
+        return report;
+    }
+
+    // 放弃当前暂存的帧（不发送）
+    void discard()
+    {
+        std::lock_guard<std::mutex> dlk(dispatch_mutex_);
+        for (auto& h : hands_) {
+            std::lock_guard<std::mutex> lk(h->mutex);
+            h->armed = false;
+            h->open_ended = false;
+            h->staged.clear();
+        }
+    }
+
+    // 通道线程套用 lane_thread 失败的第一个错误
+    std::error_code threadError() const { return thread_result_.error(); }
+
+    SyncDispatchStats stats() const
+    {
+        std::lock_guard<std::mutex> lk(stats_mutex_);
+        return stats_;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Frame {
+        uint32_t id = 0;
+        uint8_t  len = 0;
+        uint8_t  data[64];
+    };
+
+    struct Hand {
+        CanTxCallback tx;
+        size_t index = 0;
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool armed = false;
+        bool open_ended = false;  // 有未给出帧数的指令，需按静默判断
+        size_t expected = 0;
+        std::vector<Frame> staged;
+        Clock::time_point last_capture;
+        SyncHandTiming timing;    // 放行期间由所在通道线程写入
+    };
+
+    struct Lane {
+        unsigned id = 0;
+        std::vector<Hand*> hands;
+        bool active = false;
+        std::thread thread;
+    };
+
+    static int64_t nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    Hand* handAt(size_t i) const
+    {
+        std::lock_guard<std::mutex> lk(dispatch_mutex_);
+        if (i >= hands_.size()) throw InvalidParameterException("SyncDispatcher: hand index out of range");
+        return hands_[i].get();
+    }
+
+    Lane& laneLocked(unsigned id)
+    {
+        for (auto& l : lanes_) {
+            if (l->id == id) return *l;
+        }
+        std::unique_ptr<Lane> l(new Lane);
+        l->id = id;
+        Lane* lp = l.get();
+        {
+            std::lock_guard<std::mutex> lk(lane_mutex_);
+            lanes_.push_back(std::move(l));
+        }
+        if (id != 0) {
+            const ThreadConfig tc = config_.lane_thread.named(std::to_string(id));
+            lp->thread = std::thread([this, lp, tc] {
+                thread_result_.apply(tc);
+                runLane(*lp);
+            });
+        }
+        return *lp;
+    }
+
+    // 自旋到放行时刻，然后按帧轮流交错发送各手的暂存帧
+    static void sendFrames(const std::vector<Hand*>& hands, int64_t release_ns)
+    {
+        if (hands.empty()) return;
+        while (nowNs() < release_ns) {
+        }
+        size_t round = 0;
+        bool more = true;
+        while (more) {
+            more = false;
+            for (Hand* h : hands) {
+                if (!h->armed || round >= h->staged.size()) continue;
+                const Frame& f = h->staged[round];
+                const int64_t t0 = nowNs();
+                if (h->tx(f.id, f.data, f.len) != 0) ++h->timing.errors;
+                if (round == 0) h->timing.first_ns = t0;
+                h->timing.last_ns = nowNs();
+                more = true;
+            }
+            ++round;
+        }
+    }
+
+    void runLane(Lane& lane)
+    {
+        uint64_t seen = 0;
+        std::unique_lock<std::mutex> lk(lane_mutex_);
+        for (;;) {
+            lane_cv_.wait(lk, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_) return;
+            seen = generation_;
+            if (!lane.active) continue;
+            const int64_t release_ns = release_ns_;
+            lk.unlock();
+            sendFrames(lane.hands, release_ns);
+            lk.lock();
+            ++lanes_done_;
+            lane_cv_.notify_all();
+        }
+    }
+
+    SyncDispatchConfig config_;
+    mutable std::mutex dispatch_mutex_;  // 保护 hands_，串行化 release()
+    std::vector<std::unique_ptr<Hand>> hands_;
+
+    std::mutex lane_mutex_;
+    std::condition_variable lane_cv_;
+    std::vector<std::unique_ptr<Lane>> lanes_;
+    uint64_t generation_ = 0;
+    int64_t  release_ns_ = 0;
+    size_t   lanes_done_ = 0;
+    bool     stopping_ = false;
+    ThreadConfigResult thread_result_;
+
+    mutable std::mutex stats_mutex_;
+    SyncDispatchStats stats_;
+};
+
+}  // namespace api
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_SYNC_DISPATCH_H
@@ -0,0 +1,440 @@
+#ifndef LINKERHAND_TACTILE_BUFFER_H
+#define LINKERHAND_TACTILE_BUFFER_H
+
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include "HandState.h"
+#include "RequestPlan.h"
+#include "TactileLayout.h"
+#include "TactileFeatures.h"
+#include "communication/CommunicationCallbacks.h"
+#include "core/Seqlock.h"
+
+namespace linkerhand {
+namespace api {
+
+// 完整触觉帧的元信息
+struct TactileStamp {
+    uint64_t frame      = 0;   // 第几个完整帧，0 表示尚无
+    int64_t  capture_ns = 0;   // 首个分包到达时刻，steady_clock 纳秒
+    int64_t  span_ns    = 0;   // 首末分包的时间跨度
+};
+
+// 只读视图：不拥有数据，按 layout 的步长索引
+struct TactileView {
+    const uint8_t* fingers = nullptr;
+    const uint8_t* palm    = nullptr;
+    TactileLayout  layout;
+    TactileStamp   force_stamp;
+    TactileStamp   palm_stamp;
+
+    const uint8_t* finger(size_t f) const { return fingers + f * layout.finger_stride; }
+    uint8_t at(size_t f, size_t r, size_t c) const
+    {
+        return fingers[f * layout.finger_stride + r * layout.row_stride + c];
+    }
+    uint8_t palmAt(size_t r, size_t c) const { return palm[r * layout.palm_row_stride + c]; }
+};
+
+// 从整手快照取视图（HandState 的触觉字段本就是连续存放）
+inline TactileView tactileView(const FingerTactileSample& force, const PalmTactileSample& palm)
+{
+    TactileView v;
+    v.fingers = force.cells;
+    v.palm    = palm.cells;
+    v.layout  = makeTactileLayout(force.fingers, force.rows, force.cols, palm.rows, palm.cols);
+    return v;
+}
+
+inline TactileView tactileView(const HandState& st) { return tactileView(st.force, st.palm); }
+
+// 触觉帧缓冲：直接在 RX 路径上解析触觉应答帧，写入固定容量的连续缓冲区。
+//
+// getForce() / getPalmForce() 每次返回三层 / 两层嵌套 vector，数十次堆分配且内存不连续。
+// TactileBuffer 经 wrapRx() 旁路观察应答帧（帧仍交给 SDK，原有接口不受影响），
+// 读取端拷进调用方缓冲区或在读区间内零拷贝访问，均不分配内存。
+// 请求仍需有人发出：PollScheduler 轮询 Force/PalmForce 通道，或调用 request() 直接经 TX 发送。
+//
+// 帧装配：一轮请求的应答跨越数毫秒，逐行覆盖会让读者看到新旧行混杂。分包先写入后台缓冲区并按位
+// 记录已到的分包，手指（全部指 × 行）或掌心（全部行 × 段）到齐后才整块发布到 Seqlock 保护的
+// 前台帧，并附帧号与采集时刻。手指与掌心各自装配、各自计帧。
+//
+// 轮次：每轮请求的首帧（手指为第一指的请求，掌心为掌心请求）发出时轮次号加一，其后到达的分包都记在
+// 新一轮上，上一轮未收齐的装配随即丢弃。经 request() 发出的请求自动计轮；经 SDK 发出的请求（例如
+// PollScheduler 调 getForce）须把 TX 回调交给 wrapTx()（或在 TX 回调中调用 onTx()）才能计轮。
+// 从未见过请求时退而以首个被请求的分包（第一指第 0 行、掌心第 0 行第 0 段）作为一轮的起点。
+// 此外装配中又收到已到过的分包，或跨度超过装配时限，也丢弃该轮。丢弃均计入 stats().incomplete，
+// 因此不会发布由两轮分包拼成的帧。
+//
+// 特征阶段：每发布一个完整帧，在 RX 线程上用 TactileFeatureKernel 计算各指（掌心）的总压、
+// 接触面积、质心与峰值，经 features() 读取或 setFeatureCallback() 订阅。
+// L7/L10 每指只有 4 个不同物理量，不做矩阵特征。
+//
+// 协议（经典 CAN，帧 ID 即 HAND_TYPE）：
+//   L6/L21/L25  b1~b5, 8 字节：data[1] 高 4 位为行号，data[2..7] 为 6 个单元
+//   O6          b1~b5, 6 字节：data[1] 高 4 位为行号，data[2..5] 为 4 个单元
+//   L7/L10      0x28~0x32：data[1..4] 为该指 4 个量
+//   掌心        b6, 8 字节：data[1] 行号，data[2] 起始列，data[3..7] 为 5 个单元
+class TactileBuffer
+{
+public:
+    struct Frame {
+        TactileStamp        force_stamp;
+        TactileStamp        palm_stamp;
+        FingerTactileSample force;
+        PalmTactileSample   palm;
+    };
+
+    // 在 RX 线程内同步调用，须尽快返回
+    using FeatureCallback = std::function<void(const TactileFeatures&)>;
+
+    struct Stats {
+        uint64_t rows        = 0;   // 已收到的分包数
+        uint64_t ignored     = 0;   // 命令字匹配但长度或行列越界而丢弃的帧
+        uint64_t frames      = 0;   // 已发布的完整手指帧
+        uint64_t palm_frames = 0;   // 已发布的完整掌心帧
+        uint64_t incomplete  = 0;   // 未收齐即被新一轮覆盖、混入其他轮次或超时而丢弃的装配
+    };
+
+    TactileBuffer(LINKER_HAND model, HAND_TYPE hand, PalmSensor palm = PalmSensor::TSSP_JZG)
+        : model_(model), can_id_(static_cast<uint32_t>(hand)), layout_(tactileLayout(model, palm))
+    {
+        back_force_.fingers = layout_.fingers;
+        back_force_.rows    = layout_.rows;
+        back_force_.cols    = layout_.cols;
+        back_palm_.rows     = layout_.palm_rows;
+        back_palm_.cols     = layout_.palm_cols;
+        frame_.update([this](Frame& f) {
+            f.force = back_force_;
+            f.palm  = back_palm_;
+        });
+        force_asm_.expected = layout_.fingers * layout_.rows;
+        palm_asm_.expected  = layout_.palm_rows * palmChunks();
+        features_enabled_ = layout_.rows > 1;
+        current_.fingers  = features_enabled_ ? layout_.fingers : 0;
+        current_.has_palm = layout_.palm_rows != 0;
+        features_.store(current_);
+        requests_ = readRequestFrames(model, PollChannel::Force);
+        force_requests_ = requests_.size();
+        if (layout_.palm_rows) {
+            const auto palm_req = readRequestFrames(model, PollChannel::PalmForce);
+            requests_.insert(requests_.end(), palm_req.begin(), palm_req.end());
+        }
+    }
+
+    TactileBuffer(const TactileBuffer&) = delete;
+    TactileBuffer& operator=(const TactileBuffer&) = delete;
+
+    const TactileLayout& layout() const { return layout_; }
+
+    // RX 回调收到一帧后调用（只能由一个线程调用）；属于本手触觉应答返回 true
+    bool onRx(uint32_t can_id, const uint8_t* data, size_t len)
+    {
+        if (can_id != can_id_ || len == 0) return false;
+        const uint8_t cmd = data[0];
+        switch (model_) {
+            case L6:
+            case L21:
+            case L25:
+            case O6: {
+                if (cmd == 0xb6 && layout_.palm_rows) return onPalm(data, len);
+                if (cmd < 0xb1 || cmd > 0xb5) return false;
+                const size_t cells = layout_.cols;
+                const size_t row = data[1] >> 4;
+                if (len != cells + 2 || row >= layout_.rows) return ignore();
+                writeFinger(cmd - 0xb1, row, data + 2, cells);
+                return true;
+            }
+            case L7:
+            case L10: {
+                static const uint8_t kCmds[5] = {0x28, 0x29, 0x30, 0x31, 0x32};
+                for (size_t f = 0; f < 5; ++f) {
+                    if (cmd != kCmds[f]) continue;
+                    if (len < 5) return ignore();
+                    writeFinger(f, 0, data + 1, 4);
+                    return true;
+                }
+                return false;
+            }
+            default:
+                return false;
+        }
+    }
+
+    // TX 回调内、实际发送前调用：识别每轮触觉请求的首帧并开始新一轮装配（可与 onRx 不在同一线程）
+    void onTx(uint32_t can_id, const uint8_t* data, size_t len)
+    {
+        if (can_id != can_id_ || len == 0) return;
+        if (force_requests_ && matches(requests_[0], data, len)) {
+            force_round_.fetch_add(1, std::memory_order_acq_rel);
+        } else if (requests_.size() > force_requests_ && matches(requests_[force_requests_], data, len)) {
+            palm_round_.fetch_add(1, std::memory_order_acq_rel);
+        }
+    }
+
+    // 包装原始 TX / RX 回调，返回可直接交给 LinkerHandApi::setCanTxCallback / setCanRxCallback 的回调
+    CanTxCallback wrapTx(CanTxCallback tx)
+    {
+        return [this, tx = std::move(tx)](uint32_t can_id, const uint8_t* data, uintptr_t len) -> int32_t {
+            onTx(can_id, data, static_cast<size_t>(len));
+            return tx(can_id, data, len);
+        };
+    }
+
+    CanRxCallback wrapRx(CanRxCallback rx)
+    {
+        return [this, rx = std::move(rx)](uint32_t* can_id, uint8_t* data, uint8_t* len) -> int32_t {
+            const int32_t rc = rx(can_id, data, len);
+            if (rc == 0) onRx(*can_id, data, *len);
+            return rc;
+        };
+    }
+
+    // 经原始 TX 回调发出一轮触觉请求（手指 + 掌心），不经 SDK 队列、不分配内存；返回发送失败的帧数
+    size_t request(const CanTxCallback& tx)
+    {
+        size_t failed = 0;
+        for (size_t i = 0; i < requests_.size(); ++i) {
+            const RequestFrame& r = requests_[i];
+            if (i == 0) force_round_.fetch_add(1, std::memory_order_acq_rel);
+            if (i == force_requests_) palm_round_.fetch_add(1, std::memory_order_acq_rel);
+            if (tx(can_id_, r.data, r.len) != 0) ++failed;
+        }
+        return failed;
+    }
+
+    // 一轮装配允许的最大跨度，默认 100ms
+    template <typename Rep, typename Period>
+    void setAssemblyTimeout(const std::chrono::duration<Rep, Period>& timeout)
+    {
+        timeout_ns_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count(),
+                          std::memory_order_relaxed);
+    }
+
+    // 拷贝最新完整手指帧到调用方缓冲区（layout().fingerCells() 字节）；容量不足返回 false
+    bool copyFingers(uint8_t* dst, size_t capacity, TactileStamp* stamp = nullptr) const
+    {
+        const size_t n = layout_.fingerCells();
+        if (capacity < n) return false;
+        TactileStamp st;
+        frame_.read([&](const Frame& f) {
+            std::memcpy(dst, f.force.cells, n);
+            st = f.force_stamp;
+        });
+        if (stamp) *stamp = st;
+        return true;
+    }
+
+    bool copyPalm(uint8_t* dst, size_t capacity, TactileStamp* stamp = nullptr) const
+    {
+        const size_t n = layout_.palmCells();
+        if (capacity < n) return false;
+        TactileStamp st;
+        frame_.read([&](const Frame& f) {
+            std::memcpy(dst, f.palm.cells, n);
+            st = f.palm_stamp;
+        });
+        if (stamp) *stamp = st;
+        return true;
+    }
+
+    // 零拷贝读取：fn(const TactileView&) 在读区间内执行，期间被新分包覆盖会重试，
+    // 因此 fn 只应计算并把结果写进局部变量 / 调用方缓冲区。视图不得带出 fn。
+    template <typename Fn>
+    void read(Fn&& fn) const
+    {
+        frame_.read([&](const Frame& f) {
+            TactileView v;
+            v.fingers = f.force.cells;
+            v.palm    = f.palm.cells;
+            v.layout  = layout_;
+            v.force_stamp = f.force_stamp;
+            v.palm_stamp  = f.palm_stamp;
+            fn(static_cast<const TactileView&>(v));
+        });
+    }
+
+    // 接触判定阈值（单元值大于阈值计入接触面积），默认 0
+    void setFeatureThreshold(uint8_t threshold) { threshold_.store(threshold, std::memory_order_relaxed); }
+
+    // 在接入 RX 回调之前设置
+    void setFeatureCallback(FeatureCallback cb) { feature_cb_ = std::move(cb); }
+
+    // 最新特征（约 100 字节拷贝，不分配）
+    TactileFeatures features() const
+    {
+        TactileFeatures out;
+        features_.load(out);
+        return out;
+    }
+
+    // 整帧拷贝（与 HandState 的触觉字段同构）
+    void load(Frame& out) const { frame_.load(out); }
+
+    // 前台帧的发布次数，变化即有新的完整帧
+    uint64_t version() const { return frame_.version(); }
+
+    Stats stats() const
+    {
+        Stats s;
+        s.rows        = rows_.load(std::memory_order_relaxed);
+        s.ignored     = ignored_.load(std::memory_order_relaxed);
+        s.frames      = frames_.load(std::memory_order_relaxed);
+        s.palm_frames = palm_frames_.load(std::memory_order_relaxed);
+        s.incomplete  = incomplete_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    bool ignore()
+    {
+        ignored_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // 一轮装配：按位记录已到的分包。掌心每行 5 单元一段，共 palm_rows × palmChunks() 段
+    static constexpr size_t kMaxSegments = 128;
+    struct Assembly {
+        std::bitset<kMaxSegments> seen;
+        uint64_t round   = 0;   // 开始装配时的轮次号
+        size_t  count    = 0;
+        size_t  expected = 0;
+        int64_t first_ns = 0;
+        int64_t last_ns  = 0;
+    };
+
+    size_t palmChunks() const { return (layout_.palm_cols + 4) / 5; }
+
+    static int64_t nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static bool matches(const RequestFrame& r, const uint8_t* data, size_t len)
+    {
+        return len == r.len && std::memcmp(data, r.data, len) == 0;
+    }
+
+    // 登记一个分包。已发出新一轮请求、（未见过请求时）首个被请求的分包再次到达、重复分包或超时，
+    // 都说明上一轮已断，丢弃后从该分包重新开始。收齐返回 true
+    bool admit(Assembly& a, size_t segment, const std::atomic<uint64_t>& rounds)
+    {
+        const int64_t now = nowNs();
+        const uint64_t round = rounds.load(std::memory_order_acquire);
+        if (a.count) {
+            const bool next_round = round != 0 ? round != a.round : segment == 0;
+            if (next_round || a.seen.test(segment) || now - a.first_ns > timeout_ns_.load(std::memory_order_relaxed)) {
+                incomplete_.fetch_add(1, std::memory_order_relaxed);
+                a.seen.reset();
+                a.count = 0;
+            }
+        }
+        if (a.count == 0) {
+            a.first_ns = now;
+            a.round = round;
+        }
+        a.seen.set(segment);
+        ++a.count;
+        a.last_ns = now;
+        rows_.fetch_add(1, std::memory_order_relaxed);
+        return a.count == a.expected;
+    }
+
+    static TactileStamp finish(Assembly& a, uint64_t frame)
+    {
+        TactileStamp st;
+        st.frame      = frame;
+        st.capture_ns = a.first_ns;
+        st.span_ns    = a.last_ns - a.first_ns;
+        a.seen.reset();
+        a.count = 0;
+        return st;
+    }
+
+    void writeFinger(size_t finger, size_t row, const uint8_t* cells, size_t n)
+    {
+        std::memcpy(back_force_.cells + finger * layout_.finger_stride + row * layout_.row_stride, cells, n);
+        if (!admit(force_asm_, finger * layout_.rows + row, force_round_)) return;
+
+        const TactileStamp st = finish(force_asm_, frames_.fetch_add(1, std::memory_order_relaxed) + 1);
+        const size_t bytes = layout_.fingerCells();
+        frame_.update([&](Frame& f) {
+            std::memcpy(f.force.cells, back_force_.cells, bytes);
+            f.force_stamp = st;
+        });
+        if (features_enabled_) {
+            extractor_.setThreshold(threshold_.load(std::memory_order_relaxed));
+            for (size_t i = 0; i < layout_.fingers; ++i) current_.finger[i] = extractor_.finger(back_force_, i);
+            publishFeatures();
+        }
+    }
+
+    void publishFeatures()
+    {
+        ++current_.sequence;
+        features_.store(current_);
+        if (feature_cb_) feature_cb_(current_);
+    }
+
+    bool onPalm(const uint8_t* data, size_t len)
+    {
+        const size_t row = data[1];
+        const size_t col = data[2];
+        if (len != 8 || row >= layout_.palm_rows || col >= layout_.palm_cols) return ignore();
+        const size_t n = std::min<size_t>(5, layout_.palm_cols - col);
+        std::memcpy(back_palm_.cells + row * layout_.palm_row_stride + col, data + 3, n);
+        if (!admit(palm_asm_, row * palmChunks() + col / 5, palm_round_)) return true;
+
+        const TactileStamp st = finish(palm_asm_, palm_frames_.fetch_add(1, std::memory_order_relaxed) + 1);
+        const size_t bytes = layout_.palmCells();
+        frame_.update([&](Frame& f) {
+            std::memcpy(f.palm.cells, back_palm_.cells, bytes);
+            f.palm_stamp = st;
+        });
+        extractor_.setThreshold(threshold_.load(std::memory_order_relaxed));
+        current_.palm = extractor_.palm(back_palm_);
+        publishFeatures();
+        return true;
+    }
+
+    LINKER_HAND model_;
+    uint32_t can_id_;
+    TactileLayout layout_;
+    std::vector<RequestFrame> requests_;
+    size_t force_requests_ = 0;             // requests_ 中手指请求的个数（其后为掌心请求）
+    std::atomic<uint64_t> force_round_{0};  // 已发出的请求轮次，0 表示从未见过请求
+    std::atomic<uint64_t> palm_round_{0};
+    Seqlock<Frame> frame_;
+    std::atomic<uint64_t> rows_{0};
+    std::atomic<uint64_t> ignored_{0};
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> palm_frames_{0};
+    std::atomic<uint64_t> incomplete_{0};
+    std::atomic<int64_t>  timeout_ns_{100000000};
+
+    // 后台装配缓冲，仅 RX 线程访问
+    FingerTactileSample back_force_;
+    PalmTactileSample   back_palm_;
+    Assembly force_asm_;
+    Assembly palm_asm_;
+
+    bool features_enabled_ = false;
+    std::atomic<uint8_t> threshold_{0};
+    FeatureCallback feature_cb_;
+    TactileFeatureExtractor extractor_;   // 仅 RX 线程访问
+    TactileFeatures current_;
+    Seqlock<TactileFeatures> features_;
+};
+
+}  // namespace api
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_TACTILE_BUFFER_H
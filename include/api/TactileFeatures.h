@@ -0,0 +1,188 @@
+#ifndef LINKERHAND_TACTILE_FEATURES_H
+#define LINKERHAND_TACTILE_FEATURES_H
+
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#include "HandState.h"
+
+namespace linkerhand {
+namespace api {
+
+// 单块触觉矩阵（一指或掌心）的接触特征
+struct ContactFeatures {
+    uint32_t total = 0;   // 全部单元压力之和
+    uint16_t area  = 0;   // 压力超过阈值的单元数
+    uint8_t  peak  = 0;   // 最大单元值
+    float    row   = 0;   // 压力加权质心（单元坐标，行）；total 为 0 时为 0
+    float    col   = 0;   // 压力加权质心（列）
+};
+
+// 整手触觉特征。可平凡拷贝，可直接放进 Seqlock。
+struct TactileFeatures {
+    uint8_t  fingers  = 0;
+    bool     has_palm = false;
+    uint64_t sequence = 0;   // 第几次更新
+    ContactFeatures finger[kMaxFingers];
+    ContactFeatures palm;
+};
+
+// 触觉特征内核：对行优先连续存放的 rows × cols 矩阵一次求出总压、接触面积、峰值和质心。
+// 行/列权重表在构造时按形状预计算；x86 上每 16 个单元一组用 SSE2 处理
+// （psadbw 求和与计面积、pmaxub 求峰值、pmaddwd 求加权和），其余平台为标量循环。
+class TactileFeatureKernel
+{
+public:
+    TactileFeatureKernel() = default;
+
+    TactileFeatureKernel(size_t rows, size_t cols) : cells_(rows * cols)
+    {
+        weight_row_.resize(cells_);
+        weight_col_.resize(cells_);
+        for (size_t i = 0; i < cells_; ++i) {
+            weight_row_[i] = static_cast<int16_t>(i / cols);
+            weight_col_[i] = static_cast<int16_t>(i % cols);
+        }
+    }
+
+    size_t cells() const { return cells_; }
+
+    ContactFeatures compute(const uint8_t* cells, uint8_t threshold) const
+    {
+        ContactFeatures out;
+        if (cells_ == 0) return out;
+        uint64_t total = 0;
+        int64_t  sum_row = 0;
+        int64_t  sum_col = 0;
+        uint32_t area = 0;
+        uint8_t  peak = 0;
+        size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i one  = _mm_set1_epi8(1);
+        const __m128i thr  = _mm_set1_epi8(static_cast<char>(threshold));
+        __m128i acc_total = zero;
+        __m128i acc_area  = zero;
+        __m128i acc_row   = zero;
+        __m128i acc_col   = zero;
+        __m128i acc_peak  = zero;
+        for (; i + 16 <= cells_; i += 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cells + i));
+            acc_total = _mm_add_epi64(acc_total, _mm_sad_epu8(v, zero));
+            acc_peak  = _mm_max_epu8(acc_peak, v);
+            // v > threshold  <=>  饱和减法结果非 0；接触单元记 1 后同样用 psadbw 累加
+            const __m128i below = _mm_cmpeq_epi8(_mm_subs_epu8(v, thr), zero);
+            acc_area = _mm_add_epi64(acc_area, _mm_sad_epu8(_mm_andnot_si128(below, one), zero));
+            const __m128i lo = _mm_unpacklo_epi8(v, zero);
+            const __m128i hi = _mm_unpackhi_epi8(v, zero);
+            const __m128i* wr = reinterpret_cast<const __m128i*>(weight_row_.data() + i);
+            const __m128i* wc = reinterpret_cast<const __m128i*>(weight_col_.data() + i);
+            acc_row = _mm_add_epi32(acc_row, _mm_add_epi32(_mm_madd_epi16(lo, _mm_loadu_si128(wr)),
+                                                           _mm_madd_epi16(hi, _mm_loadu_si128(wr + 1))));
+            acc_col = _mm_add_epi32(acc_col, _mm_add_epi32(_mm_madd_epi16(lo, _mm_loadu_si128(wc)),
+                                                           _mm_madd_epi16(hi, _mm_loadu_si128(wc + 1))));
+        }
+        alignas(16) uint64_t t64[2];
+        alignas(16) uint64_t a64[2];
+        alignas(16) int32_t  r32[4];
+        alignas(16) int32_t  c32[4];
+        alignas(16) uint8_t  p8[16];
+        _mm_store_si128(reinterpret_cast<__m128i*>(t64), acc_total);
+        _mm_store_si128(reinterpret_cast<__m128i*>(a64), acc_area);
+        _mm_store_si128(reinterpret_cast<__m128i*>(r32), acc_row);
+        _mm_store_si128(reinterpret_cast<__m128i*>(c32), acc_col);
+        _mm_store_si128(reinterpret_cast<__m128i*>(p8), acc_peak);
+        total = t64[0] + t64[1];
+        area  = static_cast<uint32_t>(a64[0] + a64[1]);
+        for (int k = 0; k < 4; ++k) {
+            sum_row += r32[k];
+            sum_col += c32[k];
+        }
+        for (int k = 0; k < 16; ++k) peak = p8[k] > peak ? p8[k] : peak;
+#endif
+        for (; i < cells_; ++i) {
+            const uint8_t v = cells[i];
+            total   += v;
+            sum_row += static_cast<int64_t>(v) * weight_row_[i];
+            sum_col += static_cast<int64_t>(v) * weight_col_[i];
+            area    += v > threshold ? 1u : 0u;
+            peak     = v > peak ? v : peak;
+        }
+        out.total = static_cast<uint32_t>(total);
+        out.area  = static_cast<uint16_t>(area);
+        out.peak  = peak;
+        if (total) {
+            out.row = static_cast<float>(static_cast<double>(sum_row) / static_cast<double>(total));
+            out.col = static_cast<float>(static_cast<double>(sum_col) / static_cast<double>(total));
+        }
+        return out;
+    }
+
+private:
+    size_t cells_ = 0;
+    std::vector<int16_t> weight_row_;
+    std::vector<int16_t> weight_col_;
+};
+
+// 整手特征提取：按手指 / 掌心的形状各持一个内核，形状变化时才重建（只在此时分配）。
+class TactileFeatureExtractor
+{
+public:
+    explicit TactileFeatureExtractor(uint8_t threshold = 0) : threshold_(threshold) {}
+
+    // 接触判定阈值：单元值大于该值计入 area
+    void setThreshold(uint8_t threshold) { threshold_ = threshold; }
+    uint8_t threshold() const { return threshold_; }
+
+    ContactFeatures finger(const FingerTactileSample& s, size_t f)
+    {
+        reshape(finger_kernel_, finger_shape_, s.rows, s.cols);
+        return finger_kernel_.compute(s.cells + f * finger_kernel_.cells(), threshold_);
+    }
+
+    ContactFeatures palm(const PalmTactileSample& s)
+    {
+        reshape(palm_kernel_, palm_shape_, s.rows, s.cols);
+        return palm_kernel_.compute(s.cells, threshold_);
+    }
+
+    // 计算全部手指与掌心；sequence 由调用方维护
+    void compute(const FingerTactileSample& force, const PalmTactileSample& palm_sample, TactileFeatures& out)
+    {
+        out.fingers  = force.fingers;
+        out.has_palm = palm_sample.rows != 0 && palm_sample.cols != 0;
+        for (size_t f = 0; f < out.fingers; ++f) out.finger[f] = finger(force, f);
+        out.palm = out.has_palm ? palm(palm_sample) : ContactFeatures{};
+    }
+
+    // PollScheduler 快照路径
+    void compute(const HandState& st, TactileFeatures& out)
+    {
+        compute(st.force, st.palm, out);
+        out.sequence = st.publish;
+    }
+
+private:
+    static void reshape(TactileFeatureKernel& k, uint32_t& shape, uint8_t rows, uint8_t cols)
+    {
+        const uint32_t s = (static_cast<uint32_t>(rows) << 8) | cols;
+        if (s == shape) return;
+        k = TactileFeatureKernel(rows, cols);
+        shape = s;
+    }
+
+    uint8_t threshold_ = 0;
+    TactileFeatureKernel finger_kernel_;
+    TactileFeatureKernel palm_kernel_;
+    uint32_t finger_shape_ = 0;
+    uint32_t palm_shape_ = 0;
+};
+
+}  // namespace api
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_TACTILE_FEATURES_H
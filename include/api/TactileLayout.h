@@ -0,0 +1,77 @@
+#ifndef LINKERHAND_TACTILE_LAYOUT_H
+#define LINKERHAND_TACTILE_LAYOUT_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/Common.h"
+
+namespace linkerhand {
+namespace api {
+
+// 掌心触觉传感器型号
+enum class PalmSensor : uint8_t {
+    None,
+    TSSP_JZG,   // 20 x 28
+    TSSP_HWK,   // 14 x 16
+};
+
+// 触觉数据形状与步长（单位：单元）。手指为 fingers × rows × cols，掌心为 palm_rows × palm_cols，均行优先。
+struct TactileLayout {
+    uint8_t fingers   = 0;
+    uint8_t rows      = 0;
+    uint8_t cols      = 0;
+    uint8_t palm_rows = 0;
+    uint8_t palm_cols = 0;
+    size_t  finger_stride = 0;    // 相邻两指的间距
+    size_t  row_stride    = 0;    // 相邻两行的间距
+    size_t  palm_row_stride = 0;
+
+    size_t fingerCells() const { return fingers * finger_stride; }
+    size_t palmCells() const { return palm_rows * palm_row_stride; }
+};
+
+inline TactileLayout makeTactileLayout(size_t fingers, size_t rows, size_t cols, size_t palm_rows, size_t palm_cols)
+{
+    TactileLayout l;
+    l.fingers   = static_cast<uint8_t>(fingers);
+    l.rows      = static_cast<uint8_t>(rows);
+    l.cols      = static_cast<uint8_t>(cols);
+    l.palm_rows = static_cast<uint8_t>(palm_rows);
+    l.palm_cols = static_cast<uint8_t>(palm_cols);
+    l.finger_stride   = rows * cols;
+    l.row_stride      = cols;
+    l.palm_row_stride = palm_cols;
+    return l;
+}
+
+// 各型号的触觉布局（与 getForce / getPalmForce 返回的形状一致）。
+// L7/L10 为每指 4 个量（法向力、切向力、切向方向、接近度）；O20、G20 无经典 CAN 触觉矩阵，返回全 0。
+inline TactileLayout tactileLayout(LINKER_HAND model, PalmSensor palm = PalmSensor::TSSP_JZG)
+{
+    size_t palm_rows = 0;
+    size_t palm_cols = 0;
+    if (model == L6 || model == O6) {
+        if (palm == PalmSensor::TSSP_JZG)      { palm_rows = 20; palm_cols = 28; }
+        else if (palm == PalmSensor::TSSP_HWK) { palm_rows = 14; palm_cols = 16; }
+    }
+    switch (model) {
+        case L6:
+        case L21:
+        case L25: return makeTactileLayout(5, 12, 6, palm_rows, palm_cols);
+        case O6:  return makeTactileLayout(5, 10, 4, palm_rows, palm_cols);
+        case L7:
+        case L10: return makeTactileLayout(5, 1, 4, 0, 0);
+        default:  break;
+    }
+    return TactileLayout{};
+}
+
+// 每指一次触觉请求的应答帧数：逐行分包的型号每行一帧，L7/L10 每指一帧；无触觉矩阵的型号为 0。
+// 读请求命令表（readRequestFrames）与回读帧开销（defaultPollChannelCost）均以此为准。
+inline size_t tactileFingerFrames(LINKER_HAND model) { return tactileLayout(model).rows; }
+
+}  // namespace api
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_TACTILE_LAYOUT_H
@@ -0,0 +1,382 @@
+#ifndef LINKERHAND_TRAJECTORY_STREAMER_H
+#define LINKERHAND_TRAJECTORY_STREAMER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "LinkerHandApi.h"
+#include "core/ThreadConfig.h"
+
+namespace linkerhand {
+namespace api {
+
+enum class TrajectoryUnits : uint8_t {
+    Raw,     // 0~255，经 setPosition 下发
+    Radian   // 弧度，经 setPositionArc 下发（SDK 内部按型号换算）
+};
+
+enum class TrajectoryProfile : uint8_t {
+    Linear,
+    Cubic,        // 三次 Hermite，途经点速度按前后点差分（Catmull-Rom），速度连续
+    MinimumJerk   // 五次最小加加速度，每段首末速度/加速度为零
+};
+
+struct TrajectoryConfig {
+    double            rate_hz = 100.0;   // 设定点输出频率
+    TrajectoryUnits   units   = TrajectoryUnits::Raw;
+    TrajectoryProfile profile = TrajectoryProfile::MinimumJerk;
+    ThreadConfig      thread;            // 输出线程的调度配置（例如 SCHED_FIFO + 独占核），失败见 threadError()
+};
+
+struct TrajectoryStats {
+    uint64_t ticks        = 0;
+    uint64_t late_ticks   = 0;   // 唤醒晚于本周期截止时刻
+    uint64_t skipped      = 0;   // 落后超过一个周期而跳过的周期数
+    uint64_t emit_errors  = 0;   // 下发设定点时抛出异常的次数，最近一次见 lastError()
+    double   max_late_us  = 0;
+};
+
+// 流式轨迹插值器。
+//
+// 调用方随时追加带时间戳的途经点，后台线程以固定频率按绝对截止时刻唤醒，在当前段上插值
+// 并下发设定点；应用侧的调度抖动不再直接变成运动抖动。追加的途经点时间若已过去，
+// 则按一个输出周期完成该段。段在开始执行时才确定系数，起点取上一段的实际终点与终点速度，
+// 因此运行中追加途经点不会造成位置或速度跳变。
+class TrajectoryStreamer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Pose  = std::vector<double>;
+
+    // api_mutex：与其他线程（如 PollScheduler::apiMutex()）共用的 LinkerHandApi 锁，可为空
+    explicit TrajectoryStreamer(LinkerHandApi& hand, TrajectoryConfig config = TrajectoryConfig(),
+                                std::mutex* api_mutex = nullptr)
+        : hand_(hand), config_(config), api_mutex_(api_mutex ? api_mutex : &own_api_mutex_)
+    {
+        if (!(config_.rate_hz > 0.0)) {
+            throw InvalidParameterException("TrajectoryStreamer: rate_hz must be positive");
+        }
+    }
+
+    ~TrajectoryStreamer() { stop(); }
+
+    TrajectoryStreamer(const TrajectoryStreamer&) = delete;
+    TrajectoryStreamer& operator=(const TrajectoryStreamer&) = delete;
+
+    // 以手当前位置（SDK 缓存的最近回读）为起点启动
+    void start()
+    {
+        Pose from;
+        {
+            std::lock_guard<std::mutex> api(*api_mutex_);
+            if (config_.units == TrajectoryUnits::Radian) {
+                from = hand_.getPositionArc();
+            } else {
+                const auto raw = hand_.getPosition();
+                from.assign(raw.begin(), raw.end());
+            }
+        }
+        start(from);
+    }
+
+    // from 为空时以第一个途经点为起点
+    void start(const Pose& from)
+    {
+        stop();
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            current_ = from;
+            velocity_.assign(from.size(), 0.0);
+            has_segment_ = false;
+            stopping_ = false;
+        }
+        running_ = true;
+        worker_ = std::thread([this] {
+            thread_result_.apply(config_.thread);
+            run();
+        });
+    }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        if (worker_.joinable()) worker_.join();
+        running_ = false;
+    }
+
+    bool isRunning() const { return running_; }
+
+    std::error_code threadError() const { return thread_result_.error(); }
+
+    // 追加途经点：在时刻 t 到达 pose
+    void append(Clock::time_point t, Pose pose)
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        const size_t dof = dofLocked();
+        if (pose.empty() || (dof != 0 && pose.size() != dof)) {
+            throw InvalidParameterException("TrajectoryStreamer::append: pose size mismatch");
+        }
+        queue_.push_back({t, std::move(pose)});
+        cv_.notify_all();
+    }
+
+    // 追加途经点：在上一个途经点（无则为此刻）之后 d 到达 pose
+    template <typename Rep, typename Period>
+    void appendAfter(const std::chrono::duration<Rep, Period>& d, Pose pose)
+    {
+        Clock::time_point base;
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            if (!queue_.empty())   base = queue_.back().t;
+            else if (has_segment_) base = segment_.t1;
+            else                   base = Clock::now();
+        }
+        append(base + std::chrono::duration_cast<Clock::duration>(d), std::move(pose));
+    }
+
+    // 丢弃未执行的途经点；正在执行的段走完后保持
+    void clear()
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        queue_.clear();
+    }
+
+    size_t pending() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return queue_.size() + (has_segment_ ? 1 : 0);
+    }
+
+    // 等全部途经点执行完毕；超时前完成返回 true
+    template <typename Rep, typename Period>
+    bool waitIdle(const std::chrono::duration<Rep, Period>& timeout)
+    {
+        std::unique_lock<std::mutex> lk(mutex_);
+        return idle_cv_.wait_for(lk, timeout, [this] { return queue_.empty() && !has_segment_; });
+    }
+
+    // 最近一次下发的设定点
+    Pose setpoint() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return current_;
+    }
+
+    TrajectoryStats stats() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return stats_;
+    }
+
+    // 最近一次下发失败的异常（如 SDK 抛出的 HandException），从未失败为空
+    std::exception_ptr lastError() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return last_error_;
+    }
+
+private:
+    struct Waypoint {
+        Clock::time_point t;
+        Pose pose;
+    };
+
+    struct Segment {
+        Clock::time_point t0, t1;
+        Pose p0, v0, p1, v1;   // v 单位：每秒
+    };
+
+    size_t dofLocked() const
+    {
+        if (!current_.empty()) return current_.size();
+        if (!queue_.empty()) return queue_.front().pose.size();
+        return 0;
+    }
+
+    // 从队首取出下一段；start 为段起始时刻
+    void beginSegmentLocked(Clock::time_point start)
+    {
+        Waypoint wp = std::move(queue_.front());
+        queue_.pop_front();
+        if (current_.empty()) {  // 无起点：第一个途经点即起点
+            current_ = wp.pose;
+            velocity_.assign(current_.size(), 0.0);
+        }
+        const auto period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / config_.rate_hz));
+        Segment s;
+        s.t0 = start;
+        s.t1 = std::max(wp.t, start + period);
+        s.p0 = current_;
+        s.p1 = std::move(wp.pose);
+        s.v0 = config_.profile == TrajectoryProfile::Cubic ? velocity_ : Pose(s.p0.size(), 0.0);
+        s.v1.assign(s.p1.size(), 0.0);
+        if (config_.profile == TrajectoryProfile::Cubic && !queue_.empty()) {
+            const auto& next = queue_.front();
+            const double span = std::chrono::duration<double>(next.t - s.t0).count();
+            if (span > 0.0) {
+                for (size_t j = 0; j < s.v1.size(); ++j) s.v1[j] = (next.pose[j] - s.p0[j]) / span;
+            }
+        }
+        segment_ = std::move(s);
+        has_segment_ = true;
+    }
+
+    // 在 now 处求值，结果写入 current_ / velocity_
+    void sampleLocked(Clock::time_point now)
+    {
+        while (true) {
+            if (has_segment_ && now >= segment_.t1) {
+                const auto end = segment_.t1;
+                current_  = segment_.p1;
+                velocity_ = segment_.v1;
+                has_segment_ = false;
+                if (!queue_.empty()) {
+                    beginSegmentLocked(end);
+                    continue;
+                }
+                idle_cv_.notify_all();
+                break;
+            }
+            if (!has_segment_) {
+                if (queue_.empty()) break;
+                beginSegmentLocked(now);
+                continue;
+            }
+            break;
+        }
+        if (!has_segment_) {
+            std::fill(velocity_.begin(), velocity_.end(), 0.0);
+            return;
+        }
+
+        const Segment& s = segment_;
+        const double T = std::chrono::duration<double>(s.t1 - s.t0).count();
+        const double u = std::clamp(std::chrono::duration<double>(now - s.t0).count() / T, 0.0, 1.0);
+        for (size_t j = 0; j < s.p0.size(); ++j) {
+            const double d = s.p1[j] - s.p0[j];
+            switch (config_.profile) {
+                case TrajectoryProfile::Linear:
+                    current_[j]  = s.p0[j] + d * u;
+                    velocity_[j] = d / T;
+                    break;
+                case TrajectoryProfile::MinimumJerk: {
+                    const double u3 = u * u * u;
+                    current_[j]  = s.p0[j] + d * u3 * (10.0 - 15.0 * u + 6.0 * u * u);
+                    velocity_[j] = d / T * 30.0 * u * u * (1.0 - u) * (1.0 - u);
+                    break;
+                }
+                case TrajectoryProfile::Cubic: {
+                    const double u2 = u * u, u3 = u2 * u;
+                    const double m0 = s.v0[j] * T, m1 = s.v1[j] * T;
+                    current_[j] = (2 * u3 - 3 * u2 + 1) * s.p0[j] + (u3 - 2 * u2 + u) * m0
+                                + (-2 * u3 + 3 * u2) * s.p1[j] + (u3 - u2) * m1;
+                    velocity_[j] = ((6 * u2 - 6 * u) * s.p0[j] + (3 * u2 - 4 * u + 1) * m0
+                                  + (-6 * u2 + 6 * u) * s.p1[j] + (3 * u2 - 2 * u) * m1) / T;
+                    break;
+                }
+            }
+        }
+    }
+
+    void emit(const Pose& sp)
+    {
+        std::lock_guard<std::mutex> api(*api_mutex_);
+        if (config_.units == TrajectoryUnits::Radian) {
+            hand_.setPositionArc(sp);
+            return;
+        }
+        raw_.resize(sp.size());
+        for (size_t j = 0; j < sp.size(); ++j) {
+            raw_[j] = static_cast<uint8_t>(std::clamp(std::lround(sp[j]), 0L, 255L));
+        }
+        hand_.setPosition(raw_);
+    }
+
+    void run()
+    {
+        const auto period = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / config_.rate_hz));
+        auto deadline = Clock::now();
+        Pose sp;
+        std::unique_lock<std::mutex> lk(mutex_);
+        while (!stopping_) {
+            const auto now = Clock::now();
+            const double late_us = std::chrono::duration<double, std::micro>(now - deadline).count();
+            ++stats_.ticks;
+            if (late_us > 0.0) {
+                stats_.max_late_us = std::max(stats_.max_late_us, late_us);
+                if (now - deadline > period / 10) ++stats_.late_ticks;
+            }
+            // 只在有运动时下发，静止保持阶段不占总线
+            const bool moving = has_segment_ || !queue_.empty();
+            sampleLocked(now);
+            if (moving && !current_.empty()) {
+                sp = current_;
+                lk.unlock();
+                std::exception_ptr error;
+                try { emit(sp); } catch (...) { error = std::current_exception(); }
+                lk.lock();
+                if (error) {
+                    ++stats_.emit_errors;
+                    last_error_ = error;
+                }
+            }
+
+            // 按绝对截止时刻推进；落后超过一个周期则跳过，避免补发一串过期设定点
+            deadline += period;
+            const auto after = Clock::now();
+            if (after > deadline + period) {
+                const auto behind = (after - deadline) / period;
+                stats_.skipped += static_cast<uint64_t>(behind);
+                deadline += period * behind;
+            }
+            if (!has_segment_ && queue_.empty()) {
+                // 空闲：等新的途经点，不空转
+                cv_.wait(lk, [this] { return stopping_ || !queue_.empty(); });
+                deadline = Clock::now();
+                continue;
+            }
+            cv_.wait_until(lk, deadline, [this] { return stopping_; });
+        }
+    }
+
+    LinkerHandApi&   hand_;
+    TrajectoryConfig config_;
+    std::mutex       own_api_mutex_;
+    std::mutex*      api_mutex_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable idle_cv_;
+    std::deque<Waypoint> queue_;
+    Segment segment_;
+    bool has_segment_ = false;
+    Pose current_;
+    Pose velocity_;
+    std::vector<uint8_t> raw_;
+    TrajectoryStats stats_;
+    std::exception_ptr last_error_;
+    bool stopping_ = false;
+    std::atomic<bool> running_{false};
+    std::thread worker_;
+    ThreadConfigResult thread_result_;
+};
+
+}  // namespace api
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_TRAJECTORY_STREAMER_H
@@ -0,0 +1,468 @@
+#ifndef CAN_BUS_DEMUX_H
+#define CAN_BUS_DEMUX_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <poll.h>
+#endif
+
+#include "communication/CommunicationCallbacks.h"
+#include "communication/ICanBus.h"
+#include "communication/ICanFD.h"
+#include "communication/IFrameLink.h"
+#include "core/ErrorCode.h"
+#include "core/ThreadConfig.h"
+
+namespace linkerhand {
+namespace communication
+{
+    // O20 扩展帧 ID 的设备号位段（右手 0x01、左手 0x02，例如 0x00200000 / 0x00400000）
+    constexpr uint32_t kDeviceIdShift = 21;
+    constexpr uint32_t kDeviceIdMask  = 0xFFu << kDeviceIdShift;
+
+    struct CanDemuxConfig {
+        size_t   queue = 1024;                   // 每个端点的接收队列帧数，满时丢弃最旧的帧
+        uint32_t extended_key_mask = kDeviceIdMask;  // 扩展帧按 (ID & mask) 路由；默认按设备号
+        std::chrono::milliseconds recv_wait{10}; // 端点 recv() / RX 回调在空队列上的最长等待
+        std::chrono::microseconds busy_poll{0};  // > 0：端点在空队列上先自旋这么久再睡眠（最低接收延迟）
+    };
+
+    struct CanDemuxStats {
+        uint64_t rx_frames = 0;  // 从底层总线取到的帧
+        uint64_t unrouted  = 0;  // 没有匹配端点（也没有默认端点）而丢弃的帧
+        uint64_t tx_frames = 0;
+        uint64_t tx_errors = 0;
+    };
+
+    struct CanEndpointStats {
+        uint64_t rx_frames  = 0;
+        uint64_t rx_dropped = 0;  // 队列溢出丢弃的帧
+        uint64_t tx_frames  = 0;
+    };
+
+    class CanBusDemux;
+
+    // 解复用器为一只手提供的虚拟总线：接收只看到路由给它的帧，发送经解复用器持有的唯一链路发出。
+    // 同时实现 ICanBus 与 ICanFD，可直接替代原先各手各自持有的总线对象；
+    // txCallback() / rxCallback() 可直接交给 LinkerHandApi。
+    class CanEndpoint : public ICanBus, public ICanFD
+    {
+    public:
+        CanEndpoint(CanBusDemux& owner, size_t capacity, std::chrono::milliseconds wait,
+                    std::chrono::microseconds busy_poll = std::chrono::microseconds(0))
+            : owner_(owner), ring_(capacity), wait_(wait), busy_poll_(busy_poll) {}
+
+        CanEndpoint(const CanEndpoint&) = delete;
+        CanEndpoint& operator=(const CanEndpoint&) = delete;
+
+        // ICanBus / ICanFD 的 send 签名相同；第三个参数（wait / is_extended）由 ID 大小决定，不再使用
+        inline void send(const std::vector<uint8_t>& data, uint32_t can_id, bool flag = false) override;
+
+        // 队列为空时等待至多 recv_wait，仍无帧返回全零帧（与 CanBus 的“无数据”约定一致）
+        CANFrame recv() override
+        {
+            CANFrame out{};
+            uint8_t buf[64];
+            uint8_t len = 0;
+            while (pop(&out.can_id, buf, &len, wait_)) {
+                if (len > 8) continue;  // 经典接口不投递 FD 帧
+                out.can_dlc = len;
+                std::memcpy(out.data, buf, len);
+                return out;
+            }
+            return CANFrame{};
+        }
+
+        CanFDFrame recv(int timeout_ms) override
+        {
+            CanFDFrame out{};
+            uint8_t len = 0;
+            if (!pop(&out.can_id, out.data, &len, std::chrono::milliseconds(timeout_ms))) return out;
+            out.valid = true;
+            out.can_dlc = lenToDlc(len);
+            out.frame_type = len > 8 ? 1 : 0;
+            out.extern_flag = out.can_id > 0x7FF ? 1 : 0;
+            return out;
+        }
+
+        bool isOpen() const override { return !closed_.load(std::memory_order_acquire); }
+
+        // 取一帧，最多等待 wait；关闭后立即返回 false
+        bool pop(uint32_t* can_id, uint8_t* data, uint8_t* len, std::chrono::milliseconds wait)
+        {
+            if (busy_poll_.count() > 0 && available_.load(std::memory_order_acquire) == 0) {
+                const auto until = std::chrono::steady_clock::now() + std::min<std::chrono::microseconds>(busy_poll_, wait);
+                while (available_.load(std::memory_order_acquire) == 0 && !closed_.load(std::memory_order_relaxed)
+                       && std::chrono::steady_clock::now() < until) {
+                }
+            }
+            std::unique_lock<std::mutex> lk(mutex_);
+            if (!cv_.wait_for(lk, wait, [this] { return count_ > 0 || closed_.load(std::memory_order_relaxed); })) {
+                return false;
+            }
+            if (count_ == 0) return false;
+            const Frame& f = ring_[head_];
+            *can_id = f.id;
+            *len = f.len;
+            std::memcpy(data, f.data, f.len);
+            head_ = (head_ + 1) % ring_.size();
+            --count_;
+            available_.store(count_, std::memory_order_release);
+            return true;
+        }
+
+        inline CanTxCallback txCallback();
+
+        CanRxCallback rxCallback()
+        {
+            return [this](uint32_t* can_id, uint8_t* data, uint8_t* len) -> int32_t {
+                return pop(can_id, data, len, wait_) ? 0 : -1;
+            };
+        }
+
+        CanEndpointStats stats() const
+        {
+            CanEndpointStats s;
+            s.rx_frames  = rx_frames_.load(std::memory_order_relaxed);
+            s.rx_dropped = rx_dropped_.load(std::memory_order_relaxed);
+            s.tx_frames  = tx_frames_.load(std::memory_order_relaxed);
+            return s;
+        }
+
+    private:
+        friend class CanBusDemux;
+
+        struct Frame {
+            uint32_t id = 0;
+            uint8_t  len = 0;
+            uint8_t  data[64];
+        };
+
+        static uint8_t lenToDlc(uint8_t len)
+        {
+            static const uint8_t kLens[] = {12, 16, 20, 24, 32, 48, 64};
+            if (len <= 8) return len;
+            for (uint8_t i = 0; i < 7; ++i) {
+                if (len <= kLens[i]) return static_cast<uint8_t>(9 + i);
+            }
+            return 15;
+        }
+
+        void push(uint32_t id, const uint8_t* data, uint8_t len)
+        {
+            {
+                std::lock_guard<std::mutex> lk(mutex_);
+                if (count_ == ring_.size()) {
+                    head_ = (head_ + 1) % ring_.size();
+                    --count_;
+                    rx_dropped_.fetch_add(1, std::memory_order_relaxed);
+                }
+                Frame& f = ring_[(head_ + count_) % ring_.size()];
+                f.id = id;
+                f.len = len > sizeof(f.data) ? static_cast<uint8_t>(sizeof(f.data)) : len;
+                std::memcpy(f.data, data, f.len);
+                ++count_;
+                available_.store(count_, std::memory_order_release);
+            }
+            rx_frames_.fetch_add(1, std::memory_order_relaxed);
+            cv_.notify_one();
+        }
+
+        void close()
+        {
+            {
+                std::lock_guard<std::mutex> lk(mutex_);
+                closed_.store(true, std::memory_order_release);
+            }
+            cv_.notify_all();
+        }
+
+        CanBusDemux& owner_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::vector<Frame> ring_;
+        size_t head_ = 0;
+        size_t count_ = 0;
+        std::chrono::milliseconds wait_;
+        std::chrono::microseconds busy_poll_;
+        std::atomic<size_t> available_{0};  // count_ 的无锁镜像，供忙轮询
+        std::atomic<bool> closed_{false};
+        std::atomic<uint64_t> rx_frames_{0};
+        std::atomic<uint64_t> rx_dropped_{0};
+        std::atomic<uint64_t> tx_frames_{0};
+    };
+
+    // 总线解复用器：一条底层链路（一个套接字）服务同一总线上的多只手。
+    // 收到的帧按 ID 查表投递到对应端点的队列：标准帧用 2048 项直接索引表，
+    // 扩展帧按 (ID & extended_key_mask) 查哈希表，均为 O(1)；没有匹配时投递到默认端点（如有）。
+    //
+    // 底层可以是 IFrameLink（由外部事件循环经 fd() + pump() 驱动，或 start() 起一个线程），
+    // 也可以是阻塞式 ICanBus（CanBus / PCANBus，必须 start()）。端点在解复用器析构后不可再用。
+    class CanBusDemux
+    {
+    public:
+        explicit CanBusDemux(std::unique_ptr<IFrameLink> link, const CanDemuxConfig& config = CanDemuxConfig())
+            : config_(config), link_(std::move(link))
+        {
+            if (!link_) throw InvalidParameterException("CanBusDemux: null link");
+            init();
+        }
+
+        explicit CanBusDemux(std::shared_ptr<ICanBus> bus, const CanDemuxConfig& config = CanDemuxConfig())
+            : config_(config), bus_(std::move(bus))
+        {
+            if (!bus_) throw InvalidParameterException("CanBusDemux: null bus");
+            init();
+        }
+
+        ~CanBusDemux()
+        {
+            stop();
+            std::lock_guard<std::mutex> lk(routes_mutex_);
+            for (auto& ep : endpoints_) ep->close();
+        }
+
+        CanBusDemux(const CanBusDemux&) = delete;
+        CanBusDemux& operator=(const CanBusDemux&) = delete;
+
+        // 按 CAN ID 建立端点：不超过 0x7FF 为标准帧精确匹配，否则按 (ID & extended_key_mask) 匹配。
+        // 同一路由键重复打开返回同一端点。
+        std::shared_ptr<CanEndpoint> open(uint32_t can_id)
+        {
+            if (can_id > 0x1FFFFFFF) throw InvalidParameterException("CanBusDemux::open: CAN ID out of range");
+            std::lock_guard<std::mutex> lk(routes_mutex_);
+            if (can_id <= 0x7FF) {
+                uint16_t& slot = std_routes_[can_id];
+                if (slot == 0) slot = addEndpointLocked();
+                return endpoints_[slot - 1];
+            }
+            uint16_t& slot = ext_routes_[can_id & config_.extended_key_mask];
+            if (slot == 0) slot = addEndpointLocked();
+            return endpoints_[slot - 1];
+        }
+
+        // 按设备号建立扩展帧端点（O20）；要求 extended_key_mask 为默认的设备号位段
+        std::shared_ptr<CanEndpoint> openDevice(uint8_t device_id)
+        {
+            if (config_.extended_key_mask != kDeviceIdMask) {
+                throw InvalidParameterException("CanBusDemux::openDevice: extended_key_mask is not the device id field");
+            }
+            return open(static_cast<uint32_t>(device_id) << kDeviceIdShift);
+        }
+
+        // 接收所有未匹配的帧（例如只有一只手、或需要旁路监听时）
+        std::shared_ptr<CanEndpoint> openDefault()
+        {
+            std::lock_guard<std::mutex> lk(routes_mutex_);
+            if (default_route_ == 0) default_route_ = addEndpointLocked();
+            return endpoints_[default_route_ - 1];
+        }
+
+        // 已建立路由的标准帧 ID（可交给 SocketCanLink::setFilter 在内核侧过滤）
+        std::vector<uint32_t> standardIds() const
+        {
+            std::lock_guard<std::mutex> lk(routes_mutex_);
+            std::vector<uint32_t> ids;
+            for (uint32_t id = 0; id < std_routes_.size(); ++id) {
+                if (std_routes_[id] != 0) ids.push_back(id);
+            }
+            return ids;
+        }
+
+        bool hasExtendedRoutes() const
+        {
+            std::lock_guard<std::mutex> lk(routes_mutex_);
+            return !ext_routes_.empty() || default_route_ != 0;
+        }
+
+        IFrameLink* link() { return link_.get(); }
+
+        // IFrameLink 底层的可读描述符；阻塞式总线返回 -1
+        int fd() const { return link_ ? link_->fd() : -1; }
+
+        // 取走链路上已到达的帧并分发，返回处理的帧数（IFrameLink 底层，由事件循环在 fd() 可读时调用）
+        size_t pump(size_t max_frames = 64)
+        {
+            if (!link_) return 0;
+            std::lock_guard<std::mutex> lk(routes_mutex_);
+            return link_->drain([this](uint32_t id, const uint8_t* data, uint8_t len) { routeLocked(id, data, len); },
+                                max_frames);
+        }
+
+        // 起一个接收线程：IFrameLink 底层 poll(fd) + pump()，阻塞式总线循环 recv()。
+        // thread 为该线程的调度配置，在线程启动时套用，失败见 threadError()。
+        void start(const ThreadConfig& thread = ThreadConfig())
+        {
+            if (running_.exchange(true)) return;
+            thread_ = std::thread([this, thread] {
+                if (!thread.empty()) {
+                    const std::error_code ec = applyToCurrentThread(thread);
+                    std::lock_guard<std::mutex> lk(tx_mutex_);
+                    thread_error_ = ec;
+                }
+                run();
+            });
+        }
+
+        std::error_code threadError()
+        {
+            std::lock_guard<std::mutex> lk(tx_mutex_);
+            return thread_error_;
+        }
+
+        // 停止接收线程；阻塞式总线需等待当前 recv() 返回
+        void stop()
+        {
+            if (!running_.exchange(false)) return;
+            if (thread_.joinable()) thread_.join();
+        }
+
+        // 经共享链路发送；线程安全
+        bool transmit(uint32_t can_id, const uint8_t* data, size_t len)
+        {
+            bool ok = false;
+            {
+                std::lock_guard<std::mutex> lk(tx_mutex_);
+                if (link_) {
+                    ok = link_->write(can_id, data, len);
+                } else if (len <= 8) {
+                    try {
+                        bus_->send(std::vector<uint8_t>(data, data + len), can_id);
+                        ok = true;
+                    } catch (const std::exception&) {
+                        ok = false;
+                    }
+                }
+            }
+            (ok ? tx_frames_ : tx_errors_).fetch_add(1, std::memory_order_relaxed);
+            return ok;
+        }
+
+        CanDemuxStats stats() const
+        {
+            CanDemuxStats s;
+            s.rx_frames = rx_frames_.load(std::memory_order_relaxed);
+            s.unrouted  = unrouted_.load(std::memory_order_relaxed);
+            s.tx_frames = tx_frames_.load(std::memory_order_relaxed);
+            s.tx_errors = tx_errors_.load(std::memory_order_relaxed);
+            return s;
+        }
+
+    private:
+        void init()
+        {
+            if (config_.queue == 0) throw InvalidParameterException("CanBusDemux: queue must be positive");
+            std_routes_.fill(0);
+        }
+
+        uint16_t addEndpointLocked()
+        {
+            if (endpoints_.size() >= 0xFFFF) throw InvalidParameterException("CanBusDemux: too many endpoints");
+            endpoints_.push_back(std::make_shared<CanEndpoint>(*this, config_.queue, config_.recv_wait, config_.busy_poll));
+            return static_cast<uint16_t>(endpoints_.size());
+        }
+
+        void routeLocked(uint32_t id, const uint8_t* data, uint8_t len)
+        {
+            rx_frames_.fetch_add(1, std::memory_order_relaxed);
+            uint16_t slot = 0;
+            if (id <= 0x7FF) {
+                slot = std_routes_[id];
+            } else if (!ext_routes_.empty()) {
+                const auto it = ext_routes_.find(id & config_.extended_key_mask);
+                if (it != ext_routes_.end()) slot = it->second;
+            }
+            if (slot == 0) slot = default_route_;
+            if (slot == 0) {
+                unrouted_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            endpoints_[slot - 1]->push(id, data, len);
+        }
+
+        void run()
+        {
+            while (running_.load(std::memory_order_acquire)) {
+                if (link_) {
+#ifndef _WIN32
+                    pollfd p{link_->fd(), POLLIN, 0};
+                    if (::poll(&p, 1, config_.busy_poll.count() > 0 ? 0 : 50) > 0) pump();
+#else
+                    if (pump() == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+#endif
+                    continue;
+                }
+                CANFrame f{};
+                try {
+                    f = bus_->recv();
+                } catch (const std::exception&) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    continue;
+                }
+                if (f.can_id == 0 && f.can_dlc == 0) continue;
+                std::lock_guard<std::mutex> lk(routes_mutex_);
+                routeLocked(f.can_id, f.data, f.can_dlc);
+            }
+        }
+
+        CanDemuxConfig config_;
+        std::unique_ptr<IFrameLink> link_;
+        std::shared_ptr<ICanBus> bus_;
+
+        // 路由表：值为 endpoints_ 下标 + 1，0 表示无路由
+        mutable std::mutex routes_mutex_;
+        std::array<uint16_t, 0x800> std_routes_;
+        std::unordered_map<uint32_t, uint16_t> ext_routes_;
+        uint16_t default_route_ = 0;
+        std::vector<std::shared_ptr<CanEndpoint>> endpoints_;
+
+        std::mutex tx_mutex_;
+        std::error_code thread_error_;
+        std::atomic<bool> running_{false};
+        std::thread thread_;
+        std::atomic<uint64_t> rx_frames_{0};
+        std::atomic<uint64_t> unrouted_{0};
+        std::atomic<uint64_t> tx_frames_{0};
+        std::atomic<uint64_t> tx_errors_{0};
+    };
+
+    inline void CanEndpoint::send(const std::vector<uint8_t>& data, uint32_t can_id, bool flag)
+    {
+        (void)flag;
+        if (closed_.load(std::memory_order_acquire)) throw CommunicationException("CanEndpoint: demux closed");
+        if (!owner_.transmit(can_id, data.data(), data.size())) {
+            throw CommunicationException("CanEndpoint: send failed");
+        }
+        tx_frames_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline CanTxCallback CanEndpoint::txCallback()
+    {
+        return [this](uint32_t can_id, const uint8_t* data, uintptr_t len) -> int32_t {
+            if (closed_.load(std::memory_order_acquire)) return -1;
+            if (!owner_.transmit(can_id, data, static_cast<size_t>(len))) return -1;
+            tx_frames_.fetch_add(1, std::memory_order_relaxed);
+            return 0;
+        };
+    }
+}  // namespace communication
+}  // namespace linkerhand
+
+namespace Communication {
+    using CanBusDemux = ::linkerhand::communication::CanBusDemux;
+    using CanEndpoint = ::linkerhand::communication::CanEndpoint;
+}
+
+#endif  // CAN_BUS_DEMUX_H
@@ -0,0 +1,74 @@
+#ifndef LINKERHAND_CAN_BUS_LOAD_H
+#define LINKERHAND_CAN_BUS_LOAD_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace linkerhand {
+namespace communication
+{
+    // CAN / CAN-FD 总线占用估算。
+    // 按 ISO 11898-1 的帧格式计算单帧在线位数，位填充取最坏情况（每 4 个同极性位插 1 位），
+    // 用于轮询调度在总线接近饱和前主动降频。结果是上界估算，不是线上实测。
+
+    struct CanBitTiming
+    {
+        uint32_t nominal_bitrate = 1000000;  // 仲裁段波特率（经典 CAN 即总线波特率）
+        uint32_t data_bitrate    = 0;        // CAN-FD 数据段波特率；0 表示与仲裁段相同
+        bool     fd              = false;    // 是否 CAN-FD 帧
+        bool     brs             = true;     // CAN-FD 是否开启波特率切换
+    };
+
+    // CAN-FD 有效载荷长度只能取 0..8/12/16/20/24/32/48/64，向上取整到合法长度
+    inline size_t canfdPaddedLength(size_t len)
+    {
+        if (len <= 8)  return len;
+        if (len <= 12) return 12;
+        if (len <= 16) return 16;
+        if (len <= 20) return 20;
+        if (len <= 24) return 24;
+        if (len <= 32) return 32;
+        if (len <= 48) return 48;
+        return 64;
+    }
+
+    // 经典 CAN 单帧最坏情况位数（含帧间隔 3 位）
+    inline uint32_t classicFrameBits(size_t payload, bool extended)
+    {
+        const uint32_t n = static_cast<uint32_t>(payload > 8 ? 8 : payload);
+        // SOF..CRC 为填充区；标准帧 34 位开销，扩展帧 54 位开销
+        const uint32_t stuffed_region = (extended ? 54u : 34u) + 8u * n;
+        const uint32_t stuff_bits = (stuffed_region - 1u) / 4u;
+        // + CRC 界定符 1 / ACK 2 / EOF 7 / IFS 3
+        return stuffed_region + stuff_bits + 13u;
+    }
+
+    // 单帧在线时长（秒），经典 CAN 与 CAN-FD 通用
+    inline double frameSeconds(size_t payload, bool extended, const CanBitTiming& timing)
+    {
+        if (timing.nominal_bitrate == 0) return 0.0;
+        if (!timing.fd) {
+            return static_cast<double>(classicFrameBits(payload, extended)) / timing.nominal_bitrate;
+        }
+
+        const uint32_t n = static_cast<uint32_t>(canfdPaddedLength(payload));
+        // 仲裁段：SOF + ID + RRS/SRR/IDE + FDF + res + BRS
+        const uint32_t arb = extended ? 36u : 17u;
+        const uint32_t arb_stuff = (arb - 1u) / 4u;
+        // 数据段：ESI + DLC + 数据 + 填充计数 4 + CRC(17/21) + CRC 固定填充位
+        const uint32_t crc = n > 16 ? 21u : 17u;
+        const uint32_t data_dyn = 5u + 8u * n;
+        const uint32_t data_bits = data_dyn + (data_dyn - 1u) / 4u + 4u + crc + (crc + 4u + 3u) / 4u;
+        // 尾部回到仲裁波特率：CRC 界定符 + ACK 2 + EOF 7 + IFS 3
+        const uint32_t tail = 13u;
+
+        const uint32_t data_rate = (timing.brs && timing.data_bitrate) ? timing.data_bitrate
+                                                                       : timing.nominal_bitrate;
+        return static_cast<double>(arb + arb_stuff + tail) / timing.nominal_bitrate
+             + static_cast<double>(data_bits) / data_rate;
+    }
+
+}  // namespace communication
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_CAN_BUS_LOAD_H
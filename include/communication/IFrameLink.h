@@ -0,0 +1,31 @@
+#ifndef I_FRAME_LINK_H
+#define I_FRAME_LINK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace linkerhand {
+namespace communication
+{
+    // 收到一帧：(CAN ID, 数据, 长度)
+    using FrameSink = std::function<void(uint32_t can_id, const uint8_t* data, uint8_t len)>;
+
+    // 可接入事件循环的帧链路：fd() 可读即有帧待取，drain() 以非阻塞方式取走当前全部帧。
+    // 与 ICanBus / ICanFD 的阻塞 recv() 不同，一个线程即可经 epoll 服务任意多条链路。
+    class IFrameLink
+    {
+    public:
+        virtual ~IFrameLink() = default;
+
+        // 非阻塞、可读即有帧的描述符，由链路持有并关闭
+        virtual int fd() const = 0;
+        // 取走当前已到达的帧（最多 max_frames 个），返回取到的帧数
+        virtual size_t drain(const FrameSink& sink, size_t max_frames = 64) = 0;
+        // 发送一帧；len 超过 8 时按 CAN FD 发送
+        virtual bool write(uint32_t can_id, const uint8_t* data, size_t len) = 0;
+    };
+}  // namespace communication
+}  // namespace linkerhand
+
+#endif  // I_FRAME_LINK_H
@@ -0,0 +1,388 @@
+#ifndef LINKERHAND_REQUEST_CORRELATOR_H
+#define LINKERHAND_REQUEST_CORRELATOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "communication/CommunicationCallbacks.h"
+
+namespace linkerhand {
+namespace communication {
+
+// 请求/应答关联器。
+//
+// 各型号的读请求是单字节命令帧，应答帧以 data[0] 回显命令字，因此 (应答 CAN ID, 命令字)
+// 足以唯一标识一个在途请求。关联器插在 TX/RX 回调与总线之间：
+//   - TX 侧登记每个读请求；在途数达到窗口上限时阻塞发送线程，直到有应答或最老请求超时；
+//   - RX 侧按键匹配在途请求，允许乱序到达；同键多个在途时按先进先出配对。
+// 多个请求因此可背靠背占满总线，整手刷新约一个往返即可完成，并可用 waitIdle() 精确等到
+// 全部应答落地，而不必按最坏情况固定睡眠。
+//
+// SDK 内部发送线程对请求帧约 1ms 一帧地节流发出；request() 绕过该队列直接经原始 TX 回调
+// 发送（应答仍经 RX 回调交给 SDK 解析、刷新缓存），是真正把多个请求同时挂在总线上的入口。
+class RequestCorrelator
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Ticket = uint64_t;
+
+    struct Config {
+        size_t window = 8;                                    // 最大在途请求数
+        std::chrono::microseconds timeout{20000};             // 无应答视为丢失的时限
+    };
+
+    struct Stats {
+        uint64_t requests  = 0;
+        uint64_t matched   = 0;
+        uint64_t timeouts  = 0;
+        uint64_t unmatched = 0;   // 收到但无对应在途请求的帧（主动上报、写指令回显等）
+        uint64_t reordered = 0;   // 应答未按发送顺序到达的次数
+        double   rtt_us    = 0;   // 往返时间指数滑动平均
+        size_t   in_flight = 0;
+    };
+
+    // 判定 TX 帧是否为需要等应答的读请求；默认单字节命令帧，预期一帧应答
+    using RequestFilter = std::function<bool(uint32_t can_id, const uint8_t* data, size_t len)>;
+    // TX 帧 → 预期应答帧数，0 表示不是读请求；设置后取代 RequestFilter（见 api::requestReplyCounter()）
+    using ReplyCounter = std::function<uint16_t(uint32_t can_id, const uint8_t* data, size_t len)>;
+    // 请求帧 ID → 期望的应答帧 ID；默认相同
+    using ReplyIdMap = std::function<uint32_t(uint32_t request_id)>;
+
+    RequestCorrelator() : RequestCorrelator(Config{}) {}
+    explicit RequestCorrelator(Config config) : config_(config)
+    {
+        if (config_.window == 0) config_.window = 1;
+    }
+
+    RequestCorrelator(const RequestCorrelator&) = delete;
+    RequestCorrelator& operator=(const RequestCorrelator&) = delete;
+
+    void setRequestFilter(RequestFilter f)
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        filter_ = std::move(f);
+    }
+
+    void setReplyCounter(ReplyCounter c)
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        reply_counter_ = std::move(c);
+    }
+
+    void setReplyIdMap(ReplyIdMap m)
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        reply_id_ = std::move(m);
+    }
+
+    void setWindow(size_t window)
+    {
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            config_.window = window ? window : 1;
+        }
+        cv_.notify_all();
+    }
+
+    // 原始发送函数（不经过 SDK 队列）；wrapTx() 会自动设置为被包装的回调
+    void setSender(CanTxCallback sender)
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        sender_ = std::move(sender);
+    }
+
+    // TX 回调内、实际发送前调用。返回票据（非读请求返回 0）。
+    Ticket onTx(uint32_t can_id, const uint8_t* data, size_t len)
+    {
+        std::unique_lock<std::mutex> lk(mutex_);
+        observed_id_ = can_id;
+        has_observed_id_ = true;
+        if (len == 0) return 0;
+        if (reply_counter_) {
+            const uint16_t replies = reply_counter_(can_id, data, len);
+            return replies ? registerLocked(lk, can_id, data[0], replies) : 0;
+        }
+        const bool is_request = filter_ ? filter_(can_id, data, len) : (len == 1);
+        if (!is_request) return 0;
+        return registerLocked(lk, can_id, data[0], 1);
+    }
+
+    // 直接发出一个读请求并登记；replies 为该请求预期的应答帧数（多帧触觉矩阵等）。
+    // 窗口满时阻塞调用方。发送失败或未设置发送函数返回 0。
+    Ticket request(uint32_t can_id, const uint8_t* data, size_t len, uint16_t replies = 1)
+    {
+        if (len == 0) return 0;
+        CanTxCallback sender;
+        Ticket t = 0;
+        {
+            std::unique_lock<std::mutex> lk(mutex_);
+            if (!sender_) return 0;
+            sender = sender_;
+            t = registerLocked(lk, can_id, data[0], replies ? replies : 1);
+        }
+        if (sender(can_id, data, len) != 0) {
+            std::lock_guard<std::mutex> lk(mutex_);
+            auto it = std::find_if(pending_.begin(), pending_.end(), [t](const Pending& p) { return p.ticket == t; });
+            if (it != pending_.end()) pending_.erase(it);
+            cv_.notify_all();
+            return 0;
+        }
+        return t;
+    }
+
+    // 最近一次经 SDK 发出的请求帧 ID（即该手的 CAN ID）；尚未观察到返回 false
+    bool observedRequestId(uint32_t& can_id) const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        can_id = observed_id_;
+        return has_observed_id_;
+    }
+
+    // RX 回调收到一帧后调用；匹配到在途请求返回 true
+    bool onRx(uint32_t can_id, const uint8_t* data, size_t len) { return match(can_id, data, len, false); }
+
+    // 等待票据的应答收齐。等待超时、或请求已因无应答被丢弃（见 Config::timeout）返回 false
+    template <typename Rep, typename Period>
+    bool wait(Ticket ticket, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        std::unique_lock<std::mutex> lk(mutex_);
+        expireLocked(Clock::now());
+        if (!cv_.wait_for(lk, timeout, [&] { return !isPendingLocked(ticket) && !isHandoffLocked(ticket); })) {
+            return false;
+        }
+        return std::find(expired_.begin(), expired_.end(), ticket) == expired_.end();
+    }
+
+    // 吞掉接下来经 wrapTx() 发出的一帧与之相同的帧（不发上总线、不登记）。
+    // 用于已由 request() 取得应答后，再调用 SDK getter 只为读取其缓存的场合；Config::timeout 内未出现则作废。
+    void suppressNext(uint32_t can_id, const uint8_t* data, size_t len)
+    {
+        if (len > sizeof(Suppressed::data)) return;
+        std::lock_guard<std::mutex> lk(mutex_);
+        Suppressed f;
+        f.can_id = can_id;
+        f.len = static_cast<uint8_t>(len);
+        std::memcpy(f.data, data, len);
+        f.until = Clock::now() + config_.timeout;
+        suppressed_.push_back(f);
+    }
+
+    // 等待当前全部在途请求落地；超时前清空返回 true
+    template <typename Rep, typename Period>
+    bool waitIdle(const std::chrono::duration<Rep, Period>& timeout)
+    {
+        const auto deadline = Clock::now() + timeout;
+        std::unique_lock<std::mutex> lk(mutex_);
+        const Ticket last = next_ticket_;
+        while (true) {
+            expireLocked(Clock::now());
+            const bool idle = std::none_of(pending_.begin(), pending_.end(),
+                                           [last](const Pending& p) { return p.ticket <= last; });
+            if (idle && handoff_.empty()) return true;
+            if (Clock::now() >= deadline) return false;
+            cv_.wait_until(lk, pending_.empty() ? deadline : std::min(deadline, pending_.front().sent + config_.timeout));
+        }
+    }
+
+    // 等到在途表清空且已静默 quiet（期间无新请求登记）；用于请求由其他线程异步发出、
+    // 调用方无法确知何时全部登记的场合。超时前满足返回 true
+    template <typename Rep, typename Period>
+    bool waitQuiet(std::chrono::microseconds quiet, const std::chrono::duration<Rep, Period>& timeout)
+    {
+        const auto deadline = Clock::now() + timeout;
+        std::unique_lock<std::mutex> lk(mutex_);
+        while (true) {
+            const auto now = Clock::now();
+            expireLocked(now);
+            if (pending_.empty() && handoff_.empty() && now - last_tx_ >= quiet) return true;
+            if (now >= deadline) return false;
+            auto wake = pending_.empty() ? last_tx_ + quiet : pending_.front().sent + config_.timeout;
+            cv_.wait_until(lk, std::min(deadline, wake));
+        }
+    }
+
+    size_t inFlight() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return pending_.size();
+    }
+
+    Stats stats() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        Stats s = stats_;
+        s.in_flight = pending_.size();
+        return s;
+    }
+
+    // 包装原始 TX/RX 回调，返回可直接交给 LinkerHandApi::setCanTxCallback / setCanRxCallback 的回调
+    CanTxCallback wrapTx(CanTxCallback tx)
+    {
+        setSender(tx);
+        return [this, tx = std::move(tx)](uint32_t can_id, const uint8_t* data, uintptr_t len) -> int32_t {
+            if (consumeSuppressed(can_id, data, static_cast<size_t>(len))) return 0;
+            onTx(can_id, data, static_cast<size_t>(len));
+            return tx(can_id, data, len);
+        };
+    }
+
+    // 经 RX 回调交给 SDK 的应答要等 SDK 解析完才算落地：收齐的请求先挂起，RX 线程下一次进入回调
+    // （上一帧已解析完毕）时才放行 wait() / waitIdle() / waitQuiet()，之后调用 getter 读到的必是新缓存
+    CanRxCallback wrapRx(CanRxCallback rx)
+    {
+        return [this, rx = std::move(rx)](uint32_t* can_id, uint8_t* data, uint8_t* len) -> int32_t {
+            releaseHandoff();
+            const int32_t rc = rx(can_id, data, len);
+            if (rc == 0) match(*can_id, data, *len, true);
+            return rc;
+        };
+    }
+
+private:
+    // defer：收齐的请求转入 handoff_，由 releaseHandoff() 放行；否则立即放行
+    bool match(uint32_t can_id, const uint8_t* data, size_t len, bool defer)
+    {
+        if (len == 0) return false;
+        const auto now = Clock::now();
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            expireLocked(now);
+            auto it = std::find_if(pending_.begin(), pending_.end(), [&](const Pending& p) {
+                return p.reply_id == can_id && p.cmd == data[0];
+            });
+            if (it == pending_.end()) {
+                ++stats_.unmatched;
+                return false;
+            }
+            if (--it->remaining > 0) return true;  // 多帧应答尚未收齐
+            if (it != pending_.begin()) ++stats_.reordered;
+            const double rtt = std::chrono::duration<double, std::micro>(now - it->sent).count();
+            stats_.rtt_us = stats_.matched == 0 ? rtt : stats_.rtt_us * 0.9 + rtt * 0.1;
+            ++stats_.matched;
+            if (defer) {
+                handoff_.push_back(it->ticket);
+                has_handoff_.store(true, std::memory_order_release);
+            }
+            pending_.erase(it);
+        }
+        cv_.notify_all();
+        return true;
+    }
+
+    void releaseHandoff()
+    {
+        if (!has_handoff_.load(std::memory_order_acquire)) return;
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            handoff_.clear();
+            has_handoff_.store(false, std::memory_order_relaxed);
+        }
+        cv_.notify_all();
+    }
+
+    struct Pending {
+        Ticket   ticket = 0;
+        uint32_t reply_id = 0;
+        uint8_t  cmd = 0;
+        uint16_t remaining = 1;
+        Clock::time_point sent;
+    };
+
+    Ticket registerLocked(std::unique_lock<std::mutex>& lk, uint32_t can_id, uint8_t cmd, uint16_t replies)
+    {
+        while (pending_.size() >= config_.window) {
+            expireLocked(Clock::now());
+            if (pending_.size() < config_.window) break;
+            cv_.wait_until(lk, pending_.front().sent + config_.timeout);
+        }
+        Pending p;
+        p.ticket    = ++next_ticket_;
+        p.reply_id  = reply_id_ ? reply_id_(can_id) : can_id;
+        p.cmd       = cmd;
+        p.remaining = replies;
+        p.sent      = Clock::now();
+        last_tx_    = p.sent;
+        pending_.push_back(p);
+        ++stats_.requests;
+        return p.ticket;
+    }
+
+    struct Suppressed {
+        uint32_t can_id = 0;
+        uint8_t  len = 0;
+        uint8_t  data[8] = {};
+        Clock::time_point until;
+    };
+
+    bool consumeSuppressed(uint32_t can_id, const uint8_t* data, size_t len)
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (suppressed_.empty()) return false;
+        const auto now = Clock::now();
+        while (!suppressed_.empty() && suppressed_.front().until <= now) suppressed_.pop_front();
+        auto it = std::find_if(suppressed_.begin(), suppressed_.end(), [&](const Suppressed& f) {
+            return f.can_id == can_id && f.len == len && std::memcmp(f.data, data, len) == 0;
+        });
+        if (it == suppressed_.end()) return false;
+        suppressed_.erase(it);
+        return true;
+    }
+
+    bool isPendingLocked(Ticket t) const
+    {
+        return std::any_of(pending_.begin(), pending_.end(), [t](const Pending& p) { return p.ticket == t; });
+    }
+
+    bool isHandoffLocked(Ticket t) const
+    {
+        return std::find(handoff_.begin(), handoff_.end(), t) != handoff_.end();
+    }
+
+    // 在途表按发送时间有序，只需从队首剔除
+    void expireLocked(Clock::time_point now)
+    {
+        bool freed = false;
+        while (!pending_.empty() && now - pending_.front().sent >= config_.timeout) {
+            // 保留最近丢弃的票据，供 wait() 区分"收到应答"与"超时丢弃"
+            expired_.push_back(pending_.front().ticket);
+            if (expired_.size() > kExpiredHistory) expired_.pop_front();
+            pending_.pop_front();
+            ++stats_.timeouts;
+            freed = true;
+        }
+        if (freed) cv_.notify_all();
+    }
+
+    Config config_;
+    RequestFilter filter_;
+    ReplyCounter reply_counter_;
+    ReplyIdMap reply_id_;
+    CanTxCallback sender_;
+    uint32_t observed_id_ = 0;
+    bool has_observed_id_ = false;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Pending> pending_;
+    static constexpr size_t kExpiredHistory = 256;
+    std::deque<Ticket> expired_;
+    std::deque<Suppressed> suppressed_;
+    std::vector<Ticket> handoff_;          // 应答已收齐、最后一帧尚在 SDK 解析中的票据
+    std::atomic<bool> has_handoff_{false};
+    Ticket next_ticket_ = 0;
+    Clock::time_point last_tx_{};
+    Stats stats_;
+};
+
+}  // namespace communication
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_REQUEST_CORRELATOR_H
@@ -0,0 +1,151 @@
+#ifdef __linux__
+#ifndef SOCKET_CAN_LINK_H
+#define SOCKET_CAN_LINK_H
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "communication/IFrameLink.h"
+#include "core/ErrorCode.h"
+
+namespace linkerhand {
+namespace communication
+{
+    // 非阻塞 SocketCAN 原始套接字链路（IFrameLink），供事件循环统一收发。
+    // 波特率由内核侧配置（ip link set canX type can bitrate ...），本类只负责打开、过滤与收发。
+    class SocketCanLink : public IFrameLink
+    {
+    public:
+        // fd_frames：开启 CAN FD 帧收发（O20）
+        explicit SocketCanLink(const std::string& interface, bool fd_frames = false)
+            : interface_(interface), fd_frames_(fd_frames)
+        {
+            socket_fd_ = ::socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, CAN_RAW);
+            if (socket_fd_ < 0) {
+                throw CommunicationException("SocketCanLink: socket failed: " + std::string(std::strerror(errno)));
+            }
+            if (fd_frames_) {
+                const int on = 1;
+                if (::setsockopt(socket_fd_, SOL_CAN_RAW, CAN_RAW_FD_FRAMES, &on, sizeof(on)) != 0) {
+                    ::close(socket_fd_);
+                    throw CommunicationException("SocketCanLink: " + interface + " does not support CAN FD");
+                }
+            }
+            sockaddr_can addr{};
+            addr.can_family = AF_CAN;
+            addr.can_ifindex = static_cast<int>(::if_nametoindex(interface.c_str()));
+            if (addr.can_ifindex == 0
+                || ::bind(socket_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+                ::close(socket_fd_);
+                throw CommunicationException("SocketCanLink: cannot bind " + interface);
+            }
+        }
+
+        ~SocketCanLink() override
+        {
+            if (socket_fd_ >= 0) ::close(socket_fd_);
+        }
+
+        SocketCanLink(const SocketCanLink&) = delete;
+        SocketCanLink& operator=(const SocketCanLink&) = delete;
+
+        const std::string& interface() const { return interface_; }
+        bool fdFrames() const { return fd_frames_; }
+
+        // 内核侧按 CAN ID 精确过滤（标准帧与扩展帧按 ID 大小区分）；空表示接收全部。
+        // 注意内核把空过滤表视为“不接收任何帧”，接收全部须装一条 {0, 0} 过滤器。
+        void setFilter(const std::vector<uint32_t>& ids)
+        {
+            std::vector<can_filter> filters;
+            if (ids.empty()) filters.push_back(can_filter{0, 0});
+            for (uint32_t id : ids) {
+                can_filter f{};
+                if (id > CAN_SFF_MASK) {
+                    f.can_id = id | CAN_EFF_FLAG;
+                    f.can_mask = CAN_EFF_MASK | CAN_EFF_FLAG | CAN_RTR_FLAG;
+                } else {
+                    f.can_id = id;
+                    f.can_mask = CAN_SFF_MASK | CAN_EFF_FLAG | CAN_RTR_FLAG;
+                }
+                filters.push_back(f);
+            }
+            if (::setsockopt(socket_fd_, SOL_CAN_RAW, CAN_RAW_FILTER, filters.data(),
+                             static_cast<socklen_t>(filters.size() * sizeof(can_filter))) != 0) {
+                throw CommunicationException("SocketCanLink: " + interface_ + " filter failed: "
+                                             + std::string(std::strerror(errno)));
+            }
+        }
+
+        // SO_BUSY_POLL：读空时在驱动中自旋至多 usec 微秒（需驱动支持 NAPI 忙轮询，不支持时无效果）
+        bool setBusyPoll(unsigned usec)
+        {
+#ifdef SO_BUSY_POLL
+            const int v = static_cast<int>(usec);
+            return ::setsockopt(socket_fd_, SOL_SOCKET, SO_BUSY_POLL, &v, sizeof(v)) == 0;
+#else
+            (void)usec;
+            return false;
+#endif
+        }
+
+        int fd() const override { return socket_fd_; }
+
+        size_t drain(const FrameSink& sink, size_t max_frames = 64) override
+        {
+            size_t n = 0;
+            canfd_frame frame{};
+            while (n < max_frames) {
+                const ssize_t r = ::read(socket_fd_, &frame, sizeof(frame));
+                if (r != static_cast<ssize_t>(CAN_MTU) && r != static_cast<ssize_t>(CANFD_MTU)) break;
+                if (frame.can_id & (CAN_ERR_FLAG | CAN_RTR_FLAG)) continue;
+                const uint32_t id = frame.can_id & ((frame.can_id & CAN_EFF_FLAG) ? CAN_EFF_MASK : CAN_SFF_MASK);
+                sink(id, frame.data, frame.len);
+                ++n;
+            }
+            return n;
+        }
+
+        // ID 超过 11 位时发扩展帧；长度超过 8（或链路为 FD 模式）时发 CAN FD 帧并开启 BRS
+        bool write(uint32_t can_id, const uint8_t* data, size_t len) override
+        {
+            const bool ext = can_id > CAN_SFF_MASK;
+            if (!fd_frames_) {
+                if (len > CAN_MAX_DLEN) return false;
+                can_frame f{};
+                f.can_id = ext ? (can_id | CAN_EFF_FLAG) : can_id;
+                f.can_dlc = static_cast<uint8_t>(len);
+                std::memcpy(f.data, data, len);
+                return ::write(socket_fd_, &f, CAN_MTU) == static_cast<ssize_t>(CAN_MTU);
+            }
+            if (len > CANFD_MAX_DLEN) return false;
+            canfd_frame f{};
+            f.can_id = ext ? (can_id | CAN_EFF_FLAG) : can_id;
+            f.len = static_cast<uint8_t>(len);
+            f.flags = CANFD_BRS;
+            std::memcpy(f.data, data, len);
+            return ::write(socket_fd_, &f, CANFD_MTU) == static_cast<ssize_t>(CANFD_MTU);
+        }
+
+    private:
+        std::string interface_;
+        bool fd_frames_ = false;
+        int socket_fd_ = -1;
+    };
+}  // namespace communication
+}  // namespace linkerhand
+
+namespace Communication {
+    using SocketCanLink = ::linkerhand::communication::SocketCanLink;
+}
+
+#endif  // SOCKET_CAN_LINK_H
+#endif  // __linux__
@@ -0,0 +1,163 @@
+#ifndef LINKERHAND_RT_CHECK_H
+#define LINKERHAND_RT_CHECK_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace linkerhand {
+namespace rtcheck {
+
+// 实时路径检查钩子：在测试程序中统计某段代码在当前线程内的堆分配次数与互斥锁获取次数。
+//
+// 计数本身只在链接了钩子的程序中生效：在测试程序的某一个 .cpp 中（且只在一个中）写
+//     LINKERHAND_RT_CHECK_HOOKS()
+// 它替换全局 operator new / delete，并在 Linux 上拦截 pthread_mutex_lock / trylock（std::mutex 即经此加锁）。
+// 未链接钩子时 RtSection 的计数恒为 0，hooksInstalled() 为 false，测试应先断言钩子已安装。
+//
+//     linkerhand::rtcheck::RtSection s;
+//     rt.setPosition(pose, n);
+//     rt.getState(state);
+//     assert(linkerhand::rtcheck::hooksInstalled() && s.allocations() == 0 && s.locks() == 0);
+struct Counters {
+    uint64_t allocations = 0;
+    uint64_t locks = 0;
+    int      depth = 0;    // 嵌套的 RtSection 数，>0 时计数
+};
+
+inline Counters& threadCounters() noexcept
+{
+    thread_local Counters c;
+    return c;
+}
+
+inline bool& hooksFlag() noexcept
+{
+    static bool installed = false;
+    return installed;
+}
+
+inline bool hooksInstalled() noexcept { return hooksFlag(); }
+
+inline void noteAllocation() noexcept
+{
+    Counters& c = threadCounters();
+    if (c.depth > 0) ++c.allocations;
+}
+
+inline void noteLock() noexcept
+{
+    Counters& c = threadCounters();
+    if (c.depth > 0) ++c.locks;
+}
+
+// 钩子中 operator delete 的释放函数；不内联，避免编译器把 new/free 配对误报为不匹配
+#if defined(__GNUC__)
+__attribute__((noinline))
+#endif
+inline void releaseBlock(void* p) noexcept
+{
+    std::free(p);
+}
+
+// 当前线程的计数区间（可嵌套）；allocations() / locks() 为自构造以来的增量
+class RtSection
+{
+public:
+    RtSection() noexcept
+    {
+        Counters& c = threadCounters();
+        ++c.depth;
+        alloc0_ = c.allocations;
+        lock0_ = c.locks;
+    }
+
+    ~RtSection() { --threadCounters().depth; }
+
+    RtSection(const RtSection&) = delete;
+    RtSection& operator=(const RtSection&) = delete;
+
+    uint64_t allocations() const noexcept { return threadCounters().allocations - alloc0_; }
+    uint64_t locks() const noexcept { return threadCounters().locks - lock0_; }
+    bool clean() const noexcept { return allocations() == 0 && locks() == 0; }
+
+private:
+    uint64_t alloc0_ = 0;
+    uint64_t lock0_ = 0;
+};
+
+}  // namespace rtcheck
+}  // namespace linkerhand
+
+#if defined(__linux__)
+#include <dlfcn.h>
+#include <pthread.h>
+// 真实函数指针惰性解析，不用局部静态变量，避免初始化守卫在加锁路径上重入
+#define LINKERHAND_RT_CHECK_LOCK_HOOK(NAME)                                                           \
+    extern "C" int NAME(pthread_mutex_t* m)                                                           \
+    {                                                                                                 \
+        using Fn = int (*)(pthread_mutex_t*);                                                         \
+        static std::atomic<Fn> real{nullptr};                                                         \
+        Fn fn = real.load(std::memory_order_acquire);                                                 \
+        if (fn == nullptr) {                                                                          \
+            fn = reinterpret_cast<Fn>(::dlsym(RTLD_NEXT, #NAME));                                     \
+            real.store(fn, std::memory_order_release);                                                \
+        }                                                                                             \
+        ::linkerhand::rtcheck::noteLock();                                                            \
+        return fn(m);                                                                                 \
+    }
+#define LINKERHAND_RT_CHECK_LOCK_HOOKS()                                                              \
+    LINKERHAND_RT_CHECK_LOCK_HOOK(pthread_mutex_lock)                                                 \
+    LINKERHAND_RT_CHECK_LOCK_HOOK(pthread_mutex_trylock)
+#else
+#define LINKERHAND_RT_CHECK_LOCK_HOOKS()
+#endif
+
+#if defined(__cpp_aligned_new)
+#define LINKERHAND_RT_CHECK_ALIGNED_HOOKS()                                                           \
+    void* operator new(std::size_t n, std::align_val_t a)                                             \
+    {                                                                                                 \
+        ::linkerhand::rtcheck::noteAllocation();                                                      \
+        void* p = nullptr;                                                                            \
+        if (::posix_memalign(&p, static_cast<std::size_t>(a), n ? n : 1) == 0) return p;              \
+        throw std::bad_alloc();                                                                       \
+    }                                                                                                 \
+    void* operator new[](std::size_t n, std::align_val_t a) { return ::operator new(n, a); }          \
+    void operator delete(void* p, std::align_val_t) noexcept { ::linkerhand::rtcheck::releaseBlock(p); } \
+    void operator delete[](void* p, std::align_val_t) noexcept { ::linkerhand::rtcheck::releaseBlock(p); } \
+    void operator delete(void* p, std::size_t, std::align_val_t) noexcept { ::linkerhand::rtcheck::releaseBlock(p); } \
+    void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { ::linkerhand::rtcheck::releaseBlock(p); }
+#else
+#define LINKERHAND_RT_CHECK_ALIGNED_HOOKS()
+#endif
+
+// 在测试程序的一个翻译单元中展开一次
+#define LINKERHAND_RT_CHECK_HOOKS()                                                                   \
+    namespace {                                                                                       \
+    struct LinkerhandRtCheckInstaller {                                                               \
+        LinkerhandRtCheckInstaller() { ::linkerhand::rtcheck::hooksFlag() = true; }                   \
+    } linkerhand_rt_check_installer;                                                                  \
+    }                                                                                                 \
+    void* operator new(std::size_t n)                                                                 \
+    {                                                                                                 \
+        ::linkerhand::rtcheck::noteAllocation();                                                      \
+        if (void* p = std::malloc(n ? n : 1)) return p;                                               \
+        throw std::bad_alloc();                                                                       \
+    }                                                                                                 \
+    void* operator new[](std::size_t n) { return ::operator new(n); }                                 \
+    void* operator new(std::size_t n, const std::nothrow_t&) noexcept                                 \
+    {                                                                                                 \
+        ::linkerhand::rtcheck::noteAllocation();                                                      \
+        return std::malloc(n ? n : 1);                                                                \
+    }                                                                                                 \
+    void* operator new[](std::size_t n, const std::nothrow_t& t) noexcept { return ::operator new(n, t); } \
+    void operator delete(void* p) noexcept { ::linkerhand::rtcheck::releaseBlock(p); }                \
+    void operator delete[](void* p) noexcept { ::linkerhand::rtcheck::releaseBlock(p); }              \
+    void operator delete(void* p, std::size_t) noexcept { ::linkerhand::rtcheck::releaseBlock(p); }   \
+    void operator delete[](void* p, std::size_t) noexcept { ::linkerhand::rtcheck::releaseBlock(p); } \
+    LINKERHAND_RT_CHECK_ALIGNED_HOOKS()                                                               \
+    LINKERHAND_RT_CHECK_LOCK_HOOKS()
+
+#endif  // LINKERHAND_RT_CHECK_H
@@ -0,0 +1,84 @@
+#ifndef LINKERHAND_SEQLOCK_H
+#define LINKERHAND_SEQLOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace linkerhand {
+
+// 单写多读顺序锁。写端从不阻塞，读端在写入进行中或读到一半被覆盖时重试，
+// 因此读端永远拿不到撕裂数据。T 必须可平凡拷贝（整体 memcpy 发布）。
+//
+// 只允许一个写线程；多个写者需在外部串行化。
+template <typename T>
+class Seqlock
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock<T>: T must be trivially copyable");
+
+public:
+    Seqlock() noexcept { std::memset(static_cast<void*>(&value_), 0, sizeof(T)); }
+
+    Seqlock(const Seqlock&) = delete;
+    Seqlock& operator=(const Seqlock&) = delete;
+
+    // 整体发布
+    void store(const T& v) noexcept
+    {
+        update([&v](T& dst) { std::memcpy(static_cast<void*>(&dst), &v, sizeof(T)); });
+    }
+
+    // 原地修改后发布，适合大结构体只改其中一个字段
+    template <typename Fn>
+    void update(Fn&& fn) noexcept
+    {
+        const uint64_t s = seq_.load(std::memory_order_relaxed);
+        seq_.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        fn(value_);
+        seq_.store(s + 2, std::memory_order_release);
+    }
+
+    // 单次尝试读取；写入进行中或读取期间被覆盖返回 false
+    bool tryLoad(T& out) const noexcept
+    {
+        const uint64_t s1 = seq_.load(std::memory_order_acquire);
+        if (s1 & 1u) return false;
+        std::memcpy(static_cast<void*>(&out), &value_, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return seq_.load(std::memory_order_relaxed) == s1;
+    }
+
+    // 读取一致快照（写端持续高频写入时自旋重试）
+    void load(T& out) const noexcept
+    {
+        while (!tryLoad(out)) {
+        }
+    }
+
+    // 零拷贝读取：在读区间内把当前值交给 fn（只读）。期间被覆盖则重试，fn 可能被调用多次，
+    // 因此 fn 在返回前不应产生外部可见的副作用（只把结果写进局部变量或调用方缓冲区）。
+    template <typename Fn>
+    void read(Fn&& fn) const
+    {
+        while (true) {
+            const uint64_t s1 = seq_.load(std::memory_order_acquire);
+            if (s1 & 1u) continue;
+            fn(static_cast<const T&>(value_));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == s1) return;
+        }
+    }
+
+    // 已完成的发布次数
+    uint64_t version() const noexcept { return seq_.load(std::memory_order_acquire) >> 1; }
+
+private:
+    std::atomic<uint64_t> seq_{0};
+    T value_;
+};
+
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_SEQLOCK_H
@@ -0,0 +1,304 @@
+#ifndef LINKERHAND_THREAD_CONFIG_H
+#define LINKERHAND_THREAD_CONFIG_H
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <alloca.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace linkerhand {
+
+enum class SchedPolicy {
+    Inherit,     // 不修改
+    Normal,      // SCHED_OTHER
+    Fifo,        // SCHED_FIFO
+    RoundRobin   // SCHED_RR
+};
+
+// 单个线程的调度配置；未设置的项保持原样
+struct ThreadConfig {
+    SchedPolicy policy = SchedPolicy::Inherit;
+    int priority = 0;              // Fifo / RoundRobin：1..99
+    std::vector<int> cpus;         // CPU 亲和性；空表示不修改
+    std::string name;              // 线程名（Linux 最长 15 字节，超出截断）
+    size_t stack_prefault = 0;     // 预先触及的栈字节数（仅在线程自身中生效）
+
+    bool empty() const
+    {
+        return policy == SchedPolicy::Inherit && cpus.empty() && name.empty() && stack_prefault == 0;
+    }
+
+    // 同一配置用于多个线程时加序号区分名字，例如 "lh-rx" → "lh-rx3"
+    ThreadConfig named(const std::string& suffix) const
+    {
+        ThreadConfig c = *this;
+        if (!c.name.empty()) c.name += suffix;
+        return c;
+    }
+};
+
+// 实时相关的整体配置：SDK 内部收发线程、本库自身线程、内存锁定与忙轮询
+struct RealTimeConfig {
+    ThreadConfig sdk_rx;    // SDK 内部接收线程（调用 RX 回调的线程）
+    ThreadConfig sdk_tx;    // SDK 内部发送线程（调用 TX 回调的线程）
+    ThreadConfig worker;    // 本库的事件循环 / 接收线程
+    ThreadConfig poller;    // 本库的回读线程（HandManager 的回读线程，调用会阻塞的 SDK getter）
+    bool lock_memory = false;               // mlockall(MCL_CURRENT | MCL_FUTURE)
+    std::chrono::microseconds busy_poll{0}; // > 0：接收侧在空队列上先自旋这么久再睡眠，事件循环改为忙轮询
+
+    bool empty() const
+    {
+        return sdk_rx.empty() && sdk_tx.empty() && worker.empty() && poller.empty() && !lock_memory
+               && busy_poll.count() == 0;
+    }
+};
+
+#ifdef __linux__
+using ThreadId = pid_t;
+
+inline ThreadId currentThreadId() noexcept { return static_cast<ThreadId>(::syscall(SYS_gettid)); }
+
+// 当前进程的全部线程
+inline std::vector<ThreadId> listThreads()
+{
+    std::vector<ThreadId> tids;
+    DIR* d = ::opendir("/proc/self/task");
+    if (d == nullptr) return tids;
+    while (dirent* e = ::readdir(d)) {
+        if (e->d_name[0] != '.') tids.push_back(static_cast<ThreadId>(std::atoi(e->d_name)));
+    }
+    ::closedir(d);
+    std::sort(tids.begin(), tids.end());
+    return tids;
+}
+
+inline std::error_code lastSystemError() noexcept { return std::error_code(errno, std::system_category()); }
+
+// 对任意线程（按内核线程号）设置调度策略、亲和性与名字；栈预触只能在线程自身中做，见 applyToCurrentThread()
+inline std::error_code applyThreadConfig(ThreadId tid, const ThreadConfig& cfg) noexcept
+{
+    if (!cfg.cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int c : cfg.cpus) {
+            if (c < 0 || c >= CPU_SETSIZE) return std::make_error_code(std::errc::invalid_argument);
+            CPU_SET(c, &set);
+        }
+        if (::sched_setaffinity(tid, sizeof(set), &set) != 0) return lastSystemError();
+    }
+    if (cfg.policy != SchedPolicy::Inherit) {
+        sched_param sp{};
+        int policy = SCHED_OTHER;
+        if (cfg.policy == SchedPolicy::Fifo) policy = SCHED_FIFO;
+        if (cfg.policy == SchedPolicy::RoundRobin) policy = SCHED_RR;
+        sp.sched_priority = policy == SCHED_OTHER ? 0 : cfg.priority;
+        if (::sched_setscheduler(tid, policy, &sp) != 0) return lastSystemError();
+    }
+    if (!cfg.name.empty()) {
+        char path[64];
+        std::snprintf(path, sizeof(path), "/proc/self/task/%d/comm", static_cast<int>(tid));
+        const int fd = ::open(path, O_WRONLY | O_CLOEXEC);
+        if (fd < 0) return lastSystemError();
+        const size_t n = std::min<size_t>(cfg.name.size(), 15);
+        const ssize_t w = ::write(fd, cfg.name.data(), n);
+        ::close(fd);
+        if (w != static_cast<ssize_t>(n)) return lastSystemError();
+    }
+    return std::error_code();
+}
+
+// 锁定进程当前与今后的全部内存，避免缺页带来的延迟
+inline std::error_code lockProcessMemory() noexcept
+{
+    if (::mlockall(MCL_CURRENT | MCL_FUTURE) != 0) return lastSystemError();
+    return std::error_code();
+}
+#else
+using ThreadId = int;
+
+inline ThreadId currentThreadId() noexcept { return 0; }
+inline std::vector<ThreadId> listThreads() { return {}; }
+
+inline std::error_code applyThreadConfig(ThreadId, const ThreadConfig& cfg) noexcept
+{
+    return cfg.policy == SchedPolicy::Inherit && cfg.cpus.empty() && cfg.name.empty()
+               ? std::error_code()
+               : std::make_error_code(std::errc::not_supported);
+}
+
+inline std::error_code lockProcessMemory() noexcept { return std::make_error_code(std::errc::not_supported); }
+#endif
+
+// 预先触及当前线程栈上的 bytes 字节，使之后的深调用不再缺页（配合 lockProcessMemory）
+inline void prefaultStack(size_t bytes) noexcept
+{
+#ifdef __linux__
+    volatile unsigned char* p = static_cast<volatile unsigned char*>(alloca(bytes));
+    for (size_t i = 0; i < bytes; i += 4096) p[i] = 0;
+#else
+    (void)bytes;
+#endif
+}
+
+// 在当前线程中套用全部配置（含栈预触）
+inline std::error_code applyToCurrentThread(const ThreadConfig& cfg) noexcept
+{
+    if (cfg.stack_prefault > 0) prefaultStack(cfg.stack_prefault);
+    return applyThreadConfig(currentThreadId(), cfg);
+}
+
+// 组件自有线程的配置结果：线程启动时 apply()，失败的第一个错误经组件的 threadError() 查询
+class ThreadConfigResult
+{
+public:
+    void apply(const ThreadConfig& cfg) noexcept
+    {
+        if (cfg.empty()) return;
+        const std::error_code ec = applyToCurrentThread(cfg);
+        if (!ec) return;
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (!error_) error_ = ec;
+    }
+
+    std::error_code error() const
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        return error_;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::error_code error_;
+};
+
+// 记录构造期间新建的线程：在创建 LinkerHandApi 前构造，之后 created() 即 SDK 内部线程。
+// 期间其他代码创建的线程也会被计入，请在初始化阶段、单线程地创建各手。
+class ThreadCapture
+{
+public:
+    ThreadCapture() : before_(listThreads()) {}
+
+    std::vector<ThreadId> created() const
+    {
+        std::vector<ThreadId> now = listThreads(), out;
+        std::set_difference(now.begin(), now.end(), before_.begin(), before_.end(), std::back_inserter(out));
+        return out;
+    }
+
+private:
+    std::vector<ThreadId> before_;
+};
+
+// 把 RX / TX 角色的配置套到 SDK 内部线程上。SDK 线程由库内部创建，无法在创建时配置；
+// 这里按 ThreadCapture 得到的线程号，在每个线程第一次调用包裹后的回调时，于该线程内套用对应角色的配置
+// （含栈预触）。不在名单中的线程（例如用户线程直接触发的发送）调用回调时不做任何修改。
+// 每个线程只检查一次，之后的调用只多一次线程局部查找。
+class SdkThreadBinder
+{
+public:
+    SdkThreadBinder(std::vector<ThreadId> tids, ThreadConfig rx, ThreadConfig tx)
+        : state_(std::make_shared<State>())
+    {
+        static std::atomic<uint64_t> next_id{1};
+        state_->id = next_id.fetch_add(1, std::memory_order_relaxed);
+        state_->tids = std::move(tids);
+        state_->rx = std::move(rx);
+        state_->tx = std::move(tx);
+    }
+
+    template <typename R, typename... Args>
+    std::function<R(Args...)> wrapRx(std::function<R(Args...)> fn) const { return wrap(std::move(fn), true); }
+
+    template <typename R, typename... Args>
+    std::function<R(Args...)> wrapTx(std::function<R(Args...)> fn) const { return wrap(std::move(fn), false); }
+
+    // 尚未调用过回调的 SDK 线程数
+    size_t pending() const
+    {
+        std::lock_guard<std::mutex> lk(state_->mutex);
+        return state_->tids.size();
+    }
+
+    // 第一个套用失败的错误（例如缺少 CAP_SYS_NICE 时设置 SCHED_FIFO 返回 EPERM）
+    std::error_code error() const
+    {
+        std::lock_guard<std::mutex> lk(state_->mutex);
+        return state_->error;
+    }
+
+private:
+    struct State {
+        uint64_t id = 0;
+        std::mutex mutex;
+        std::vector<ThreadId> tids;
+        ThreadConfig rx;
+        ThreadConfig tx;
+        std::error_code error;
+
+        void claim(bool rx_role)
+        {
+            const ThreadId self = currentThreadId();
+            {
+                std::lock_guard<std::mutex> lk(mutex);
+                auto it = std::find(tids.begin(), tids.end(), self);
+                if (it == tids.end()) return;
+                tids.erase(it);
+            }
+            const std::error_code ec = applyToCurrentThread(rx_role ? rx : tx);
+            if (ec) {
+                std::lock_guard<std::mutex> lk(mutex);
+                if (!error) error = ec;
+            }
+        }
+    };
+
+    // 本线程是否第一次经过 id 对应的包裹回调
+    static bool firstVisit(uint64_t id)
+    {
+        thread_local std::vector<uint64_t> seen;
+        if (std::find(seen.begin(), seen.end(), id) != seen.end()) return false;
+        seen.push_back(id);
+        return true;
+    }
+
+    template <typename R, typename... Args>
+    std::function<R(Args...)> wrap(std::function<R(Args...)> fn, bool rx_role) const
+    {
+        std::shared_ptr<State> st = state_;
+        return [st, rx_role, fn = std::move(fn)](Args... args) -> R {
+            if (firstVisit(st->id)) st->claim(rx_role);
+            return fn(std::forward<Args>(args)...);
+        };
+    }
+
+    std::shared_ptr<State> state_;
+};
+
+}  // namespace linkerhand
+
+#endif  // LINKERHAND_THREAD_CONFIG_H